@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/dump/compression_pool.h"
+
+#include <exception>
+#include <utility>
+
+#include "mysqlshdk/libs/utils/logger.h"
+
+namespace mysqlsh {
+namespace dump {
+
+Compression_pool::Compression_pool(std::size_t threads) {
+  for (std::size_t i = 0; i < threads; ++i) {
+    m_threads.emplace_back(&Compression_pool::run, this);
+  }
+}
+
+Compression_pool::~Compression_pool() { shutdown(); }
+
+void Compression_pool::push(Task &&task) { m_tasks.push(std::move(task)); }
+
+void Compression_pool::shutdown() {
+  if (m_threads.empty()) {
+    return;
+  }
+
+  m_tasks.shutdown(m_threads.size());
+
+  for (auto &t : m_threads) {
+    t.join();
+  }
+
+  m_threads.clear();
+}
+
+void Compression_pool::run() {
+  while (true) {
+    const auto task = m_tasks.pop();
+
+    if (!task) {
+      break;
+    }
+
+    try {
+      task();
+    } catch (const std::exception &e) {
+      log_error("Unexpected exception in compression thread: %s", e.what());
+    } catch (...) {
+      log_error("Unexpected exception in compression thread");
+    }
+  }
+}
+
+}  // namespace dump
+}  // namespace mysqlsh
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MODULES_UTIL_DUMP_COMPRESSION_POOL_H_
+#define MODULES_UTIL_DUMP_COMPRESSION_POOL_H_
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "mysqlshdk/libs/utils/synchronized_queue.h"
+
+namespace mysqlsh {
+namespace dump {
+
+/**
+ * Pool of threads which compress and write blocks of data prepared by the
+ * dump workers, allowing workers to fetch rows from the server while the
+ * previous block is being compressed.
+ */
+class Compression_pool final {
+ public:
+  using Task = std::function<void()>;
+
+  Compression_pool() = delete;
+  explicit Compression_pool(std::size_t threads);
+
+  Compression_pool(const Compression_pool &) = delete;
+  Compression_pool(Compression_pool &&) = delete;
+
+  Compression_pool &operator=(const Compression_pool &) = delete;
+  Compression_pool &operator=(Compression_pool &&) = delete;
+
+  ~Compression_pool();
+
+  /**
+   * Schedules the given task, task must not throw.
+   */
+  void push(Task &&task);
+
+  /**
+   * Executes all pending tasks and stops the threads.
+   */
+  void shutdown();
+
+ private:
+  void run();
+
+  shcore::Synchronized_queue<Task> m_tasks;
+  std::vector<std::thread> m_threads;
+};
+
+}  // namespace dump
+}  // namespace mysqlsh
+
+#endif  // MODULES_UTIL_DUMP_COMPRESSION_POOL_H_
@@ -35,6 +35,7 @@ constexpr auto k_field_terminator = '\t';
 constexpr auto k_line_terminator = '\n';
 
 constexpr auto k_escaped_characters = "\\\t\n";
+constexpr size_t k_escaped_characters_length = 3;
 
 constexpr auto k_null = "\\N";
 constexpr size_t k_null_length = 2;
@@ -43,7 +44,9 @@ constexpr size_t k_null_length = 2;
 
 Default_dump_writer::Default_dump_writer(
     std::unique_ptr<mysqlshdk::storage::IFile> out)
-    : Dump_writer(std::move(out)) {}
+    : Dump_writer(std::move(out)),
+      m_escape_table(create_escape_table(k_escaped_characters,
+                                         k_escaped_characters_length)) {}
 
 void Default_dump_writer::store_preamble(
     const std::vector<mysqlshdk::db::Column> &metadata) {
@@ -53,8 +56,21 @@ void Default_dump_writer::store_preamble(
 }
 
 void Default_dump_writer::store_row(const mysqlshdk::db::IRow *row) {
+  const char *data = nullptr;
+  std::size_t length = 0;
+
+  for (uint32_t idx = 0; idx < m_num_fields; ++idx) {
+    row->get_raw_data(idx, &data, &length);
+    store_field(data, length, idx);
+  }
+
+  finish_row();
+}
+
+void Default_dump_writer::store_row(const char *const *data,
+                                    const unsigned long *lengths) {
   for (uint32_t idx = 0; idx < m_num_fields; ++idx) {
-    store_field(row, idx);
+    store_field(data[idx], lengths[idx], idx);
   }
 
   finish_row();
@@ -96,16 +112,12 @@ void Default_dump_writer::read_metadata(
   buffer()->set_fixed_length(fixed_length);
 }
 
-void Default_dump_writer::store_field(const mysqlshdk::db::IRow *row,
+void Default_dump_writer::store_field(const char *data, std::size_t length,
                                       uint32_t idx) {
   if (0 != idx) {
     buffer()->append_fixed(k_field_terminator);
   }
 
-  const char *data = nullptr;
-  std::size_t length = 0;
-  row->get_raw_data(idx, &data, &length);
-
   bool is_null = nullptr == data;
 
   if (!is_null) {
@@ -124,57 +136,8 @@ void Default_dump_writer::store_field(const mysqlshdk::db::IRow *row,
     store_null();
   } else {
     buffer()->will_write(2 * length);
-    const auto end = data + length;
-
-    for (auto p = data; p != end; ++p) {
-      const auto c = *p;
-      char to_write = 0;
-
-      // note: this doesn't produce output consistent with SELECT .. INTO
-      // OUTFILE (i.e. tabs are escaped), but LOAD DATA INFILE handles
-      // this correctly and escaping i.e. carriage return characters helps
-      // with readability
-
-      switch (c) {
-        case '\0':
-          to_write = '0';
-          break;
-
-        case '\b':
-          to_write = 'b';
-          break;
-
-        case '\n':
-          to_write = 'n';
-          break;
-
-        case '\r':
-          to_write = 'r';
-          break;
-
-        case '\t':
-          to_write = 't';
-          break;
-
-        case 0x1A:  // ASCII 26
-          to_write = 'Z';
-          break;
-
-        default:
-          if (c == k_escaped_characters[0] || c == k_escaped_characters[1] ||
-              c == k_escaped_characters[2]) {
-            to_write = c;
-          }
-          break;
-      }
-
-      if (0 != to_write) {
-        buffer()->append(k_fields_escaped_by);
-        buffer()->append(to_write);
-      } else {
-        buffer()->append(c);
-      }
-    }
+    buffer()->append_escaped(data, length, k_fields_escaped_by,
+                             m_escape_table);
   }
 }
 
@@ -28,12 +28,20 @@
 
 #include "mysqlshdk/libs/storage/compressed_file.h"
 
+#include "modules/util/dump/compression_pool.h"
+
 namespace mysqlsh {
 namespace dump {
 
 using mysqlshdk::storage::IFile;
 using mysqlshdk::storage::Mode;
 
+namespace {
+
+constexpr std::size_t k_default_block_size = 2 * 1024 * 1024;
+
+}  // namespace
+
 Dump_write_result &Dump_write_result::operator+=(const Dump_write_result &rhs) {
   m_data_bytes += rhs.m_data_bytes;
   m_bytes_written += rhs.m_bytes_written;
@@ -54,6 +62,46 @@ void Dump_writer::Buffer::append_fixed(const std::string &s) noexcept {
   m_fixed_length_remaining -= length;
 }
 
+void Dump_writer::Buffer::append_escaped(const char *data, std::size_t length,
+                                         char escape,
+                                         const Escape_table &table) noexcept {
+  const auto needs_escaping = [&table](const char *p) {
+    return table[static_cast<unsigned char>(*p)];
+  };
+
+  const auto end = data + length;
+  auto begin = data;
+
+  while (begin != end) {
+    auto p = begin;
+
+    // skip the characters which do not need to be escaped, eight at a time
+    while (end - p >= 8 &&
+           !(needs_escaping(p) | needs_escaping(p + 1) | needs_escaping(p + 2) |
+             needs_escaping(p + 3) | needs_escaping(p + 4) |
+             needs_escaping(p + 5) | needs_escaping(p + 6) |
+             needs_escaping(p + 7))) {
+      p += 8;
+    }
+
+    while (p != end && !needs_escaping(p)) {
+      ++p;
+    }
+
+    if (p != begin) {
+      append(begin, p - begin);
+    }
+
+    if (p != end) {
+      append(escape);
+      append(needs_escaping(p));
+      ++p;
+    }
+
+    begin = p;
+  }
+}
+
 void Dump_writer::Buffer::clear() noexcept {
   m_ptr = m_data.get();
   m_length = 0;
@@ -74,6 +122,11 @@ void Dump_writer::Buffer::will_write(std::size_t bytes) {
   }
 }
 
+void Dump_writer::Buffer::reserve_fixed_length() {
+  m_fixed_length_remaining = m_fixed_length;
+  will_write(0);
+}
+
 void Dump_writer::Buffer::resize(std::size_t requested_capacity) {
   std::size_t new_capacity = m_capacity;
 
@@ -91,8 +144,32 @@ void Dump_writer::Buffer::resize(std::size_t requested_capacity) {
   }
 }
 
+Dump_writer::Escape_table Dump_writer::create_escape_table(
+    const char *escaped_characters, std::size_t count) {
+  Escape_table table{};
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto c = escaped_characters[i];
+    table[static_cast<unsigned char>(c)] = c;
+  }
+
+  // note: this doesn't produce output consistent with SELECT .. INTO OUTFILE
+  // (i.e. tabs are escaped), but LOAD DATA INFILE handles this correctly and
+  // escaping i.e. carriage return characters helps with readability
+  table[static_cast<unsigned char>('\0')] = '0';
+  table[static_cast<unsigned char>('\b')] = 'b';
+  table[static_cast<unsigned char>('\n')] = 'n';
+  table[static_cast<unsigned char>('\r')] = 'r';
+  table[static_cast<unsigned char>('\t')] = 't';
+  table[0x1A] = 'Z';  // ASCII 26
+
+  return table;
+}
+
 Dump_writer::Dump_writer(std::unique_ptr<IFile> out)
-    : m_output(std::move(out)), m_buffer(std::make_unique<Buffer>()) {}
+    : m_output(std::move(out)),
+      m_buffer(std::make_unique<Buffer>()),
+      m_block_size(k_default_block_size) {}
 
 void Dump_writer::open() {
   if (!output()->is_open()) {
@@ -100,45 +177,82 @@ void Dump_writer::open() {
   }
 }
 
+void Dump_writer::set_compression_pool(Compression_pool *pool) {
+  m_compression_pool = pool;
+
+  if (m_compression_pool) {
+    m_block = std::make_unique<Buffer>();
+    m_pending = std::make_unique<Pending_block>();
+  }
+}
+
+void Dump_writer::set_block_size(std::size_t size) {
+  assert(size > 0);
+  m_block_size = size;
+}
+
 void Dump_writer::close() {
+  if (m_pending) {
+    try {
+      // the block has to be processed before the file is closed, if it has
+      // failed, error was already reported or the dump is being aborted
+      wait_for_block();
+    } catch (...) {
+    }
+  }
+
   if (output()->is_open()) {
     output()->close();
   }
 
   // Once closed, the writer handle is released
   m_output.reset();
+
+  // writers are kept until the whole dump finishes, release the memory used
+  // by the blocks
+  m_buffer.reset();
+  m_block.reset();
 }
 
 Dump_write_result Dump_writer::write_preamble(
     const std::vector<mysqlshdk::db::Column> &metadata) {
   buffer()->clear();
   store_preamble(metadata);
-  return write_buffer("preamble");
+  return buffered_write(0, false);
 }
 
 Dump_write_result Dump_writer::write_row(const mysqlshdk::db::IRow *row) {
-  buffer()->clear();
+  const auto offset = buffer()->length();
+  buffer()->reserve_fixed_length();
   store_row(row);
-  return write_buffer("row");
+  return buffered_write(offset, false);
+}
+
+Dump_write_result Dump_writer::write_row(const char *const *data,
+                                         const unsigned long *lengths) {
+  const auto offset = buffer()->length();
+  buffer()->reserve_fixed_length();
+  store_row(data, lengths);
+  return buffered_write(offset, false);
 }
 
 Dump_write_result Dump_writer::write_postamble() {
-  buffer()->clear();
+  const auto offset = buffer()->length();
   store_postamble();
-  return write_buffer("postamble");
+  return buffered_write(offset, true);
 }
 
-Dump_write_result Dump_writer::write_buffer(const char *context) const {
+Dump_write_result Dump_writer::write_buffer(const Buffer &buffer,
+                                            const char *context) const {
   Dump_write_result result;
 
-  result.m_data_bytes = buffer()->length();
+  result.m_data_bytes = buffer.length();
 
   if (result.m_data_bytes > 0) {
     using mysqlshdk::storage::Compressed_file;
     const auto compressed = dynamic_cast<Compressed_file *>(output());
     const auto size = compressed ? compressed->file()->tell() : 0;
-    const auto bytes_written =
-        output()->write(buffer()->data(), result.m_data_bytes);
+    const auto bytes_written = output()->write(buffer.data(), buffer.length());
 
     if (bytes_written < 0) {
       throw std::runtime_error("Failed to write " + std::string(context) +
@@ -152,5 +266,82 @@ Dump_write_result Dump_writer::write_buffer(const char *context) const {
   return result;
 }
 
+Dump_write_result Dump_writer::buffered_write(std::size_t offset, bool flush) {
+  // data bytes are reported immediately, so that the offsets stored in the
+  // index file are exact, bytes written once the block has been written
+  Dump_write_result result;
+  result.m_data_bytes = buffer()->length() - offset;
+
+  if (!flush && buffer()->length() < m_block_size) {
+    return result;
+  }
+
+  if (!m_compression_pool) {
+    result.m_bytes_written =
+        write_buffer(*buffer(), "data block").bytes_written();
+    buffer()->clear();
+    return result;
+  }
+
+  // only one block per file can be compressed at a time, the next one is
+  // filled in the meantime
+  result.m_bytes_written = wait_for_block().m_bytes_written;
+
+  std::swap(m_buffer, m_block);
+  buffer()->clear();
+  buffer()->set_fixed_length(m_block->fixed_length());
+
+  {
+    std::lock_guard<std::mutex> lock(m_pending->mutex);
+    m_pending->in_progress = true;
+  }
+
+  m_compression_pool->push([this]() {
+    uint64_t bytes_written = 0;
+    std::exception_ptr exception;
+
+    try {
+      bytes_written = write_buffer(*m_block, "data block").bytes_written();
+    } catch (...) {
+      exception = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_pending->mutex);
+      m_pending->in_progress = false;
+      m_pending->bytes_written += bytes_written;
+      m_pending->exception = exception;
+    }
+
+    m_pending->done.notify_all();
+  });
+
+  if (flush) {
+    result.m_bytes_written += wait_for_block().m_bytes_written;
+  }
+
+  return result;
+}
+
+Dump_write_result Dump_writer::wait_for_block() {
+  Dump_write_result result;
+  std::exception_ptr exception;
+
+  {
+    std::unique_lock<std::mutex> lock(m_pending->mutex);
+    m_pending->done.wait(lock, [this]() { return !m_pending->in_progress; });
+
+    result.m_bytes_written = m_pending->bytes_written;
+    m_pending->bytes_written = 0;
+    std::swap(exception, m_pending->exception);
+  }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+
+  return result;
+}
+
 }  // namespace dump
 }  // namespace mysqlsh
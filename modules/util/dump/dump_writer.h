@@ -24,9 +24,13 @@
 #ifndef MODULES_UTIL_DUMP_DUMP_WRITER_H_
 #define MODULES_UTIL_DUMP_DUMP_WRITER_H_
 
+#include <array>
 #include <cassert>
+#include <condition_variable>
 #include <cstring>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -37,6 +41,8 @@
 namespace mysqlsh {
 namespace dump {
 
+class Compression_pool;
+
 class Dump_write_result final {
  public:
   Dump_write_result() : Dump_write_result("unknown", "unknown") {}
@@ -92,14 +98,47 @@ class Dump_writer {
 
   mysqlshdk::storage::IFile *output() const { return m_output.get(); }
 
+  /**
+   * Rows are going to be accumulated into blocks, which are then compressed
+   * and written by the given pool. Number of bytes written is reported once
+   * the block has been processed.
+   */
+  void set_compression_pool(Compression_pool *pool);
+
+  /**
+   * Formatted rows are accumulated until the block of the given size is
+   * filled, only then the data is written to the output file.
+   */
+  void set_block_size(std::size_t size);
+
   Dump_write_result write_preamble(
       const std::vector<mysqlshdk::db::Column> &metadata);
 
   Dump_write_result write_row(const mysqlshdk::db::IRow *row);
 
+  /**
+   * Writes a row given as raw field values (nullptr if value is NULL) and
+   * their lengths, avoids per-field calls through the IRow interface.
+   */
+  Dump_write_result write_row(const char *const *data,
+                              const unsigned long *lengths);
+
   Dump_write_result write_postamble();
 
  protected:
+  /**
+   * Maps a character to the one which follows the escape character, 0 if the
+   * character does not need to be escaped.
+   */
+  using Escape_table = std::array<char, 256>;
+
+  /**
+   * Creates the escape table, escaping the given characters and the special
+   * characters (\0, \b, \n, \r, \t, \Z) the same way as LOAD DATA does.
+   */
+  static Escape_table create_escape_table(const char *escaped_characters,
+                                          std::size_t count);
+
   class Buffer final {
    public:
     Buffer();
@@ -137,12 +176,23 @@ class Dump_writer {
       m_length += length;
     }
 
+    /**
+     * Appends the escaped data, runs of characters which do not need to be
+     * escaped are copied at once. Caller needs to reserve 2 * length bytes.
+     */
+    void append_escaped(const char *data, std::size_t length, char escape,
+                        const Escape_table &table) noexcept;
+
     void clear() noexcept;
 
     void set_fixed_length(std::size_t fixed_length);
 
     void will_write(std::size_t bytes);
 
+    void reserve_fixed_length();
+
+    inline std::size_t fixed_length() const noexcept { return m_fixed_length; }
+
    private:
     void resize(std::size_t requested_capacity);
 
@@ -162,13 +212,38 @@ class Dump_writer {
 
   virtual void store_row(const mysqlshdk::db::IRow *row) = 0;
 
+  virtual void store_row(const char *const *data,
+                         const unsigned long *lengths) = 0;
+
   virtual void store_postamble() = 0;
 
-  Dump_write_result write_buffer(const char *context) const;
+  Dump_write_result write_buffer(const Buffer &buffer,
+                                 const char *context) const;
+
+  Dump_write_result buffered_write(std::size_t offset, bool flush);
+
+  Dump_write_result wait_for_block();
+
+  struct Pending_block {
+    std::mutex mutex;
+    std::condition_variable done;
+    bool in_progress = false;
+    uint64_t bytes_written = 0;
+    std::exception_ptr exception;
+  };
 
   std::unique_ptr<mysqlshdk::storage::IFile> m_output;
 
   std::unique_ptr<Buffer> m_buffer;
+
+  std::size_t m_block_size;
+
+  Compression_pool *m_compression_pool = nullptr;
+
+  // block which is being compressed
+  std::unique_ptr<Buffer> m_block;
+
+  std::unique_ptr<Pending_block> m_pending;
 };
 
 }  // namespace dump
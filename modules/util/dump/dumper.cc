@@ -41,6 +41,7 @@
 #include "mysqlshdk/include/shellcore/interrupt_handler.h"
 #include "mysqlshdk/include/shellcore/shell_init.h"
 #include "mysqlshdk/include/shellcore/shell_options.h"
+#include "mysqlshdk/libs/db/mysql/result.h"
 #include "mysqlshdk/libs/db/mysql/session.h"
 #include "mysqlshdk/libs/db/mysqlx/session.h"
 #include "mysqlshdk/libs/storage/compressed_file.h"
@@ -56,6 +57,7 @@
 #include "mysqlshdk/libs/utils/utils_string.h"
 
 #include "modules/mod_utils.h"
+#include "modules/util/dump/compression_pool.h"
 #include "modules/util/dump/console_with_progress.h"
 #include "modules/util/dump/default_dump_writer.h"
 #include "modules/util/dump/dump_utils.h"
@@ -83,6 +85,19 @@ static constexpr auto k_dump_in_progress_ext = ".dumping";
 
 static constexpr const int k_mysql_server_net_write_timeout = 5 * 60;
 
+// tables with at least this many rows are chunked by multiple threads
+static constexpr uint64_t k_parallel_chunking_row_count = 1'000'000;
+
+// minimum number of chunks in a range which is chunked by a single thread
+static constexpr uint64_t k_chunks_per_range = 4;
+
+// chunk boundaries of tables with at least this many rows are refined using
+// EXPLAIN SELECT COUNT(*)
+static constexpr uint64_t k_refine_chunks_row_count = 1'000'000;
+
+// chunks at the end of a table are no smaller than 1/n of the requested size
+static constexpr double k_min_chunk_fraction = 4.0;
+
 const auto k_ignored_users = {"mysql.infoschema", "mysql.session", "mysql.sys"};
 
 std::string quote_value(const std::string &value, mysqlshdk::db::Type type) {
@@ -124,6 +139,33 @@ void write_json(std::unique_ptr<mysqlshdk::storage::IFile> file,
 
 }  // namespace
 
+// state shared by the threads which are chunking the same table
+struct Dumper::Table_chunking final {
+  Table_task task;
+  std::vector<Column_info> columns;
+  mysqlshdk::db::Type type;
+  // initial estimate, based on the average row length
+  uint64_t rows_per_chunk = 0;
+  // estimated number of rows per a single value of an integer index
+  double rows_per_value = 1.0;
+  // estimated number of rows of the whole table which are not in any chunk
+  // yet, chunks get smaller once the end of the table is near
+  std::atomic<uint64_t> remaining_rows{0};
+  std::atomic<std::size_t> next_index{0};
+  // sub-ranges are chunked in parallel, but chunks get their indexes in key
+  // order: chunks of a sub-range are held until all the previous sub-ranges
+  // are chunked
+  std::mutex ranges_mutex;
+  std::size_t current_range = 0;
+  std::vector<bool> chunked_ranges;
+  std::vector<std::vector<Range_info>> held_chunks;
+  // last chunk of the table, held until all sub-ranges are chunked
+  Range_info last_range;
+  // statistics of chunks which were already dumped
+  std::atomic<uint64_t> dumped_rows{0};
+  std::atomic<uint64_t> dumped_bytes{0};
+};
+
 class Dumper::Synchronize_workers final {
  public:
   Synchronize_workers() = default;
@@ -181,7 +223,7 @@ class Dumper::Table_worker final {
           mysqlshdk::utils::Rate_limit(m_dumper->m_options.max_rate());
 
       while (true) {
-        const auto func = m_dumper->m_worker_tasks.pop();
+        const auto func = m_dumper->m_worker_tasks->pop(m_id);
 
         if (m_dumper->m_worker_interrupt) {
           return;
@@ -240,10 +282,18 @@ class Dumper::Table_worker final {
     query += shcore::sqlstring(" FROM !.!", 0) << table.schema << table.name;
 
     if (!table.range.begin.empty()) {
-      query += shcore::sqlstring(" WHERE ! BETWEEN ", 0) << table.index;
-      query += quote_value(table.range.begin, table.range.type);
-      query += " AND ";
-      query += quote_value(table.range.end, table.range.type);
+      if (table.range.end_exclusive) {
+        query += shcore::sqlstring(" WHERE (! >= ", 0) << table.index;
+        query += quote_value(table.range.begin, table.range.type);
+        query += shcore::sqlstring(" AND ! < ", 0) << table.index;
+        query += quote_value(table.range.end, table.range.type);
+        query += ")";
+      } else {
+        query += shcore::sqlstring(" WHERE ! BETWEEN ", 0) << table.index;
+        query += quote_value(table.range.begin, table.range.type);
+        query += " AND ";
+        query += quote_value(table.range.end, table.range.type);
+      }
 
       if (table.include_nulls) {
         query += shcore::sqlstring(" OR ! IS NULL", 0) << table.index;
@@ -266,12 +316,16 @@ class Dumper::Table_worker final {
     const uint64_t update_every = 2000;
     uint64_t rows_written_per_idx = 0;
     const uint64_t write_idx_every = 500;
+    uint64_t rows_written_per_file = 0;
     Dump_write_result bytes_written;
     mysqlshdk::utils::Profile_timer timer;
 
     timer.stage_begin("dumping");
 
     const auto result = m_session->query(prepare_query(table));
+    // classic protocol results provide direct access to the row data
+    const auto raw_result =
+        std::dynamic_pointer_cast<mysqlshdk::db::mysql::Result>(result);
 
     shcore::on_leave_scope close_files([&table]() {
       table.index_file->close();
@@ -284,16 +338,38 @@ class Dumper::Table_worker final {
     bytes_written_per_file += bytes_written;
     bytes_written_per_update += bytes_written;
 
-    while (const auto row = result->fetch_one()) {
-      if (m_dumper->m_worker_interrupt) {
-        return;
+    while (true) {
+      if (raw_result) {
+        const auto row = raw_result->fetch_one_raw();
+
+        if (!row) {
+          break;
+        }
+
+        if (m_dumper->m_worker_interrupt) {
+          return;
+        }
+
+        bytes_written = table.writer->write_row(row->data, row->lengths);
+      } else {
+        const auto row = result->fetch_one();
+
+        if (!row) {
+          break;
+        }
+
+        if (m_dumper->m_worker_interrupt) {
+          return;
+        }
+
+        bytes_written = table.writer->write_row(row);
       }
 
-      bytes_written = table.writer->write_row(row);
       bytes_written_per_file += bytes_written;
       bytes_written_per_update += bytes_written;
       ++rows_written_per_update;
       ++rows_written_per_idx;
+      ++rows_written_per_file;
 
       if (write_idx_every == rows_written_per_idx) {
         // the idx file contains offsets to the data stream, not to binary one
@@ -335,6 +411,12 @@ class Dumper::Table_worker final {
     m_dumper->update_progress(rows_written_per_update,
                               bytes_written_per_update);
 
+    if (table.chunking) {
+      // used to adjust the size of the remaining chunks
+      table.chunking->dumped_rows += rows_written_per_file;
+      table.chunking->dumped_bytes += bytes_written_per_file.data_bytes();
+    }
+
     log_debug("Dump of `%s`.`%s` into '%s' took %f seconds",
               table.schema.c_str(), table.name.c_str(),
               table.writer->output()->full_path().c_str(),
@@ -350,13 +432,18 @@ class Dumper::Table_worker final {
     // can be move-captured by lambda
     std::shared_ptr<Table_data_task> t =
         std::make_shared<Table_data_task>(std::move(task));
-    m_dumper->m_worker_tasks.push([task = std::move(t)](Table_worker *worker) {
-      ++worker->m_dumper->m_num_threads_dumping;
+    // data of the largest tables is dumped first
+    const auto weight = t->row_count;
 
-      worker->dump_table_data(*task);
+    m_dumper->m_worker_tasks->push(
+        [task = std::move(t)](Table_worker *worker) {
+          ++worker->m_dumper->m_num_threads_dumping;
 
-      --worker->m_dumper->m_num_threads_dumping;
-    });
+          worker->dump_table_data(*task);
+
+          --worker->m_dumper->m_num_threads_dumping;
+        },
+        Worker_tasks::Priority::LOW, weight, m_id);
   }
 
   void create_table_data_task(const Table_task &task,
@@ -367,6 +454,7 @@ class Dumper::Table_worker final {
     data_task.index = task.index;
     data_task.schema = task.schema;
     data_task.columns = std::move(columns);
+    data_task.row_count = task.row_count;
     data_task.writer = m_dumper->get_table_data_writer(
         m_dumper->get_table_data_filename(task.basename));
     data_task.index_file = m_dumper->make_file(
@@ -376,28 +464,6 @@ class Dumper::Table_worker final {
     push_table_data_task(std::move(data_task));
   }
 
-  void create_table_data_task(const Table_task &task,
-                              const std::vector<Dumper::Column_info> &columns,
-                              Dumper::Range_info &&range, const std::string &id,
-                              std::size_t idx, bool last_chunk) {
-    Table_data_task data_task;
-
-    data_task.name = task.table;
-    data_task.index = task.index;
-    data_task.schema = task.schema;
-    data_task.columns = columns;
-    data_task.range = std::move(range);
-    data_task.include_nulls = 0 == idx;
-    data_task.writer = m_dumper->get_table_data_writer(
-        m_dumper->get_table_data_filename(task.basename, idx, last_chunk));
-    data_task.index_file = m_dumper->make_file(
-        m_dumper->get_table_data_filename(task.basename, idx, last_chunk) +
-        ".idx");
-    data_task.id = id;
-
-    push_table_data_task(std::move(data_task));
-  }
-
   void create_table_data_tasks(const Table_task &task) {
     auto columns = get_columns(task);
 
@@ -405,13 +471,13 @@ class Dumper::Table_worker final {
                                    is_chunked(task), task.basename,
                                    task.primary_index ? task.index : "");
 
-    auto ranges = create_ranged_tasks(task, columns);
-
-    if (0 == ranges) {
+    if (!create_ranged_tasks(task, columns)) {
       create_table_data_task(task, std::move(columns));
-      ++ranges;
+      table_data_tasks_created(task, 1);
     }
+  }
 
+  void table_data_tasks_created(const Table_task &task, std::size_t ranges) {
     current_console()->print_status(
         "Data dump for table " + Dumper::quote(task.schema, task.table) +
         " will be written to " + std::to_string(ranges) + " file" +
@@ -447,10 +513,10 @@ class Dumper::Table_worker final {
     return columns;
   }
 
-  std::size_t create_ranged_tasks(
-      const Table_task &task, const std::vector<Dumper::Column_info> &columns) {
+  bool create_ranged_tasks(const Table_task &task,
+                           const std::vector<Dumper::Column_info> &columns) {
     if (!is_chunked(task)) {
-      return 0;
+      return false;
     }
 
     auto result =
@@ -460,177 +526,397 @@ class Dumper::Table_worker final {
     const auto min_max = result->fetch_one();
 
     if (min_max->is_null(0)) {
-      return 0;
+      return false;
     }
 
+    auto chunking = std::make_shared<Table_chunking>();
+    chunking->task = task;
+    chunking->columns = columns;
+    chunking->type = min_max->get_type(0);
+    chunking->rows_per_chunk =
+        m_dumper->m_options.bytes_per_chunk() /
+        std::max(UINT64_C(1), get_average_row_length(task));
+
+    if (mysqlshdk::db::Type::Integer == chunking->type) {
+      chunk_integer_index(chunking, min_max->get_int(0), min_max->get_int(1));
+    } else if (mysqlshdk::db::Type::UInteger == chunking->type) {
+      chunk_integer_index(chunking, min_max->get_uint(0), min_max->get_uint(1));
+    } else {
+      chunk_index(chunking, {min_max->get_as_string(0),
+                             min_max->get_as_string(1), chunking->type});
+    }
+
+    return true;
+  }
+
+  template <typename T>
+  void chunk_integer_index(const std::shared_ptr<Table_chunking> &chunking,
+                           const T min, const T max) {
+    const auto &task = chunking->task;
+    const auto rows_per_chunk = chunking->rows_per_chunk;
+    const auto estimated_chunks =
+        rows_per_chunk > 0
+            ? std::max(task.row_count / rows_per_chunk, UINT64_C(1))
+            : UINT64_C(1);
+
+    // large tables are split into sub-ranges which are chunked in parallel,
+    // each one by a different thread
+    T ranges = 1;
+
+    if (task.row_count >= k_parallel_chunking_row_count) {
+      ranges = static_cast<T>(std::min<uint64_t>(
+          m_dumper->m_options.threads(),
+          std::max(estimated_chunks / k_chunks_per_range, UINT64_C(1))));
+    }
+
+    const T width = (max - min) / ranges;
+
+    if (0 == width) {
+      ranges = 1;
+    }
+
+    chunking->rows_per_value =
+        static_cast<double>(std::max(task.row_count, UINT64_C(1))) /
+        (static_cast<double>(max) - static_cast<double>(min) + 1.0);
+    chunking->remaining_rows = task.row_count;
+    chunking->chunked_ranges.resize(ranges, false);
+    chunking->held_chunks.resize(ranges);
+
+    for (T i = 1; i < ranges; ++i) {
+      const T begin = min + i * width;
+      const bool last = i + 1 == ranges;
+      const T end = last ? max : begin + width - 1;
+
+      ++m_dumper->m_chunking_tasks;
+
+      m_dumper->m_worker_tasks->push(
+          [chunking, i, begin, end, last](Table_worker *worker) {
+            ++worker->m_dumper->m_num_threads_chunking;
+
+            worker->chunk_integer_range(chunking, i, begin, end, last);
+
+            --worker->m_dumper->m_num_threads_chunking;
+          },
+          Worker_tasks::Priority::HIGH, chunking->task.row_count, m_id);
+    }
+
+    chunk_integer_range(chunking, 0, min,
+                        1 == ranges ? max : min + width - 1, 1 == ranges);
+  }
+
+  template <typename T>
+  void chunk_integer_range(const std::shared_ptr<Table_chunking> &chunking,
+                           const std::size_t sub_range, const T min,
+                           const T max, const bool last_range) {
     mysqlshdk::utils::Profile_timer timer;
     timer.stage_begin("chunking");
 
-    std::size_t ranges_count = 0;
-    std::string range_end;
-    const Range_info total = {min_max->get_as_string(0),
-                              min_max->get_as_string(1), min_max->get_type(0)};
-
-    const auto rows_per_chunk =
-        m_dumper->m_options.bytes_per_chunk() /
-        std::max(UINT64_C(1), get_average_row_length(task));
+    const auto &task = chunking->task;
+    auto current = min;
 
-    const auto generate_ranges = [&task, &columns, &ranges_count, &total,
-                                  &rows_per_chunk,
-                                  this](const auto min, const auto max) {
-      const auto estimated_chunks =
-          rows_per_chunk > 0
-              ? std::max(task.row_count / rows_per_chunk, UINT64_C(1))
-              : UINT64_C(1);
-      const auto estimated_step = (max - min + 1) / estimated_chunks;
-      const auto accuracy = std::max(estimated_step / 10, UINT64_C(10));
-
-      std::string chunk_id;
-
-      const auto next_step =
-          task.row_count < 1'000'000
-              ? std::function<decltype(min)(const decltype(min),
-                                            const decltype(min))>(
-                    [](const auto, const auto step) { return step; })
-              : [&task, &rows_per_chunk, &accuracy, &chunk_id, this](
-                    const auto from, const auto step) {
-                  auto left = from;
-                  auto right = left + 2 * step;
-
-                  auto middle = from;
-                  auto previous_row_count = rows_per_chunk;
-                  const auto comment = this->get_query_comment(task, chunk_id);
-
-                  for (int i = 0; i < 10; ++i) {
-                    middle = (left + right) / 2;
-
-                    if (middle >= right || middle <= left) {
-                      break;
-                    }
-
-                    const auto rows =
-                        m_session
-                            ->queryf(
-                                "EXPLAIN SELECT COUNT(*) FROM !.! WHERE ! "
-                                "BETWEEN ? AND ? ORDER BY ! " +
-                                    comment,
-                                task.schema, task.table, task.index, from,
-                                middle, task.index)
-                            ->fetch_one()
-                            ->get_uint(9);
-
-                    uint64_t delta = 0;
-
-                    if (rows > rows_per_chunk) {
-                      right = middle;
-                      delta = rows - rows_per_chunk;
-                    } else {
-                      left = middle;
-                      delta = rows_per_chunk - rows;
-                    }
-
-                    if (delta <= accuracy) {
-                      // we're close enough
-                      break;
-                    }
-
-                    if (rows == previous_row_count) {
-                      // we're stuck
-                      break;
-                    }
-
-                    previous_row_count = rows;
-                  }
-
-                  return middle - from;
-                };
-
-      auto current = min;
-      auto step = static_cast<decltype(min)>(estimated_step);
-
-      while (current <= max) {
-        if (m_dumper->m_worker_interrupt) {
-          return;
-        }
+    while (true) {
+      if (m_dumper->m_worker_interrupt) {
+        return;
+      }
 
-        chunk_id = std::to_string(ranges_count);
+      Range_info range;
+      range.type = chunking->type;
+      range.begin = std::to_string(current);
 
-        Range_info range;
-        range.type = total.type;
-        range.begin = std::to_string(current);
+      const auto begin = current;
+      const auto values =
+          static_cast<double>(max) - static_cast<double>(current) + 1.0;
+      const auto rows_per_chunk = get_rows_per_chunk(*chunking);
+      auto step = static_cast<T>(
+          std::min(values, std::max(rows_per_chunk / chunking->rows_per_value,
+                                    1.0)));
 
-        step = next_step(current, step);
+      step = std::max(next_step(*chunking, current, step, rows_per_chunk),
+                      static_cast<T>(1));
 
+      // if current is greater than max or close to it, finish the chunking
+      if (max - current < step || max - current - (step - 1) <= step / 4) {
+        current = max;
+      } else {
         current += step - 1;
+      }
 
-        // if current is greater than max or close to it, finish the chunking
-        if (current > max || max - current <= step / 4) {
-          current = max;
-        }
+      range.end = std::to_string(current);
 
-        range.end = std::to_string(current);
+      chunk_created(chunking.get(), (static_cast<double>(current) -
+                                     static_cast<double>(begin) + 1.0) *
+                                        chunking->rows_per_value);
 
-        create_table_data_task(task, columns, std::move(range), chunk_id,
-                               ranges_count++, current >= max);
+      if (last_range && current >= max) {
+        // the last chunk is created once all sub-ranges are chunked, so it
+        // gets the highest index
+        chunking->last_range = std::move(range);
+      } else {
+        create_range_data_task(chunking, sub_range, std::move(range));
+      }
 
-        ++current;
+      if (current >= max) {
+        break;
       }
-    };
 
-    if (mysqlshdk::db::Type::Integer == total.type) {
-      generate_ranges(min_max->get_int(0), min_max->get_int(1));
-    } else if (mysqlshdk::db::Type::UInteger == total.type) {
-      generate_ranges(min_max->get_uint(0), min_max->get_uint(1));
-    } else {
-      do {
-        const auto where =
-            0 == ranges_count
-                ? ""
-                : (shcore::sqlstring(
-                       " WHERE ! > " + quote_value(range_end, total.type), 0)
-                   << task.index)
-                      .str();
-
-        const auto chunk_id = std::to_string(ranges_count);
-        const auto comment = get_query_comment(task, chunk_id);
-
-        Range_info range;
-        range.type = total.type;
-        range.begin =
-            m_session
-                ->queryf("SELECT SQL_NO_CACHE ! FROM !.!" + where +
-                             " ORDER BY ! LIMIT 0,1 " + comment,
-                         task.index, task.schema, task.table, task.index)
-                ->fetch_one()
-                ->get_as_string(0);
+      ++current;
+    }
 
-        if (m_dumper->m_worker_interrupt) {
-          return 0;
-        }
+    timer.stage_end();
+    log_debug("Chunking of `%s`.`%s`, range [%s, %s] took %f seconds",
+              task.schema.c_str(), task.table.c_str(),
+              std::to_string(min).c_str(), std::to_string(max).c_str(),
+              timer.total_seconds_elapsed());
 
-        result = m_session->queryf("SELECT SQL_NO_CACHE ! FROM !.!" + where +
-                                       " ORDER BY ! LIMIT ?,1 " + comment,
-                                   task.index, task.schema, task.table,
-                                   task.index, rows_per_chunk - 1);
+    range_chunked(chunking, sub_range);
+  }
 
-        if (m_dumper->m_worker_interrupt) {
-          return 0;
-        }
+  double get_rows_per_chunk(const Table_chunking &chunking) const {
+    double rows = chunking.rows_per_chunk;
+    const uint64_t dumped_rows = chunking.dumped_rows;
+
+    if (dumped_rows > 0) {
+      // average row length reported by the server is only an estimate, use
+      // the size of rows which were actually dumped
+      const uint64_t dumped_bytes = chunking.dumped_bytes;
+      rows = static_cast<double>(m_dumper->m_options.bytes_per_chunk()) *
+             dumped_rows / std::max(dumped_bytes, UINT64_C(1));
+    }
 
-        const auto end = result->fetch_one();
-        range.end = end && !end->is_null(0) ? end->get_as_string(0) : total.end;
-        range_end = range.end;
+    // chunks get smaller towards the end of the table, so that all threads
+    // finish at roughly the same time
+    const auto threads = static_cast<double>(m_dumper->m_options.threads());
+    const auto remaining_rows = static_cast<double>(chunking.remaining_rows);
 
-        create_table_data_task(task, columns, std::move(range), chunk_id,
-                               ranges_count++, range_end == total.end);
-      } while (range_end != total.end);
+    if (remaining_rows < rows * threads) {
+      rows = std::max(remaining_rows / threads, rows / k_min_chunk_fraction);
     }
 
+    return std::max(rows, 1.0);
+  }
+
+  static void chunk_created(Table_chunking *chunking, double rows) {
+    const auto created = static_cast<uint64_t>(rows);
+    auto remaining = chunking->remaining_rows.load();
+
+    // row count is only an estimate, chunks may hold more rows than expected
+    while (!chunking->remaining_rows.compare_exchange_weak(
+        remaining, remaining > created ? remaining - created : 0)) {
+    }
+  }
+
+  template <typename T>
+  T next_step(const Table_chunking &chunking, const T from, const T step,
+              const double target_rows) const {
+    const auto &task = chunking.task;
+
+    if (task.row_count < k_refine_chunks_row_count) {
+      return step;
+    }
+
+    const auto rows_per_chunk = static_cast<uint64_t>(target_rows);
+    const auto accuracy = std::max(rows_per_chunk / 10, UINT64_C(10));
+
+    auto left = from;
+    auto right = left + 2 * step;
+
+    auto middle = from;
+    auto previous_row_count = rows_per_chunk;
+    const auto comment = this->get_query_comment(
+        task, std::to_string(chunking.next_index.load()));
+
+    for (int i = 0; i < 10; ++i) {
+      middle = (left + right) / 2;
+
+      if (middle >= right || middle <= left) {
+        break;
+      }
+
+      const auto rows =
+          m_session
+              ->queryf(
+                  "EXPLAIN SELECT COUNT(*) FROM !.! WHERE ! BETWEEN ? AND ? "
+                  "ORDER BY ! " +
+                      comment,
+                  task.schema, task.table, task.index, from, middle,
+                  task.index)
+              ->fetch_one()
+              ->get_uint(9);
+
+      uint64_t delta = 0;
+
+      if (rows > rows_per_chunk) {
+        right = middle;
+        delta = rows - rows_per_chunk;
+      } else {
+        left = middle;
+        delta = rows_per_chunk - rows;
+      }
+
+      if (delta <= accuracy) {
+        // we're close enough
+        break;
+      }
+
+      if (rows == previous_row_count) {
+        // we're stuck
+        break;
+      }
+
+      previous_row_count = rows;
+    }
+
+    return middle - from;
+  }
+
+  void chunk_index(const std::shared_ptr<Table_chunking> &chunking,
+                   const Range_info &total) {
+    mysqlshdk::utils::Profile_timer timer;
+    timer.stage_begin("chunking");
+
+    const auto &task = chunking->task;
+    auto begin = total.begin;
+
+    // ranges are half-open, index does not have to be unique, tasks are
+    // created as soon as the boundaries are known
+    const auto add_boundary = [&](std::string &&boundary) {
+      if (boundary == begin) {
+        return;
+      }
+
+      Range_info range;
+      range.type = total.type;
+      range.begin = std::move(begin);
+      range.end = boundary;
+      range.end_exclusive = true;
+
+      begin = std::move(boundary);
+
+      create_table_data_task(chunking, std::move(range), false);
+    };
+
+    walk_boundaries(*chunking, begin, add_boundary);
+
+    if (m_dumper->m_worker_interrupt) {
+      return;
+    }
+
+    Range_info range;
+    range.type = total.type;
+    range.begin = std::move(begin);
+    range.end = total.end;
+
+    create_table_data_task(chunking, std::move(range), true);
+
     timer.stage_end();
     log_debug("Chunking of `%s`.`%s` took %f seconds", task.schema.c_str(),
               task.table.c_str(), timer.total_seconds_elapsed());
 
-    return ranges_count;
+    table_data_tasks_created(task, chunking->next_index);
+  }
+
+  void walk_boundaries(
+      const Table_chunking &chunking, const std::string &from,
+      const std::function<void(std::string &&)> &add_boundary) const {
+    const auto &task = chunking.task;
+    const auto offset = std::max<uint64_t>(chunking.rows_per_chunk, 1) - 1;
+    auto begin = from;
+
+    // each query starts at the previous boundary and skips the rows of a
+    // single chunk, so the index is read once, this does not depend on the
+    // statistics, which may be stale
+    while (!m_dumper->m_worker_interrupt) {
+      std::string query = shcore::sqlstring(
+                              "SELECT SQL_NO_CACHE ! FROM !.! WHERE ! > ", 0)
+                          << task.index << task.schema << task.table
+                          << task.index;
+      query += quote_value(begin, chunking.type);
+      query += shcore::sqlstring(" ORDER BY ! LIMIT ?,1 ", 0)
+               << task.index << offset;
+      query += get_query_comment(task, std::to_string(chunking.next_index));
+
+      const auto row = m_session->query(query)->fetch_one();
+
+      if (!row || row->is_null(0)) {
+        break;
+      }
+
+      begin = row->get_as_string(0);
+      add_boundary(std::string{begin});
+    }
+  }
+
+  void create_table_data_task(const std::shared_ptr<Table_chunking> &chunking,
+                              Range_info &&range, bool last_chunk) {
+    const auto &task = chunking->task;
+    const std::size_t idx = chunking->next_index++;
+    const auto filename =
+        m_dumper->get_table_data_filename(task.basename, idx, last_chunk);
+    Table_data_task data_task;
+
+    data_task.name = task.table;
+    data_task.index = task.index;
+    data_task.schema = task.schema;
+    data_task.columns = chunking->columns;
+    data_task.row_count = task.row_count;
+    data_task.range = std::move(range);
+    data_task.include_nulls = 0 == idx;
+    data_task.writer = m_dumper->get_table_data_writer(filename);
+    data_task.index_file = m_dumper->make_file(filename + ".idx");
+    data_task.id = std::to_string(idx);
+    data_task.chunking = chunking;
+
+    push_table_data_task(std::move(data_task));
+  }
+
+  void create_range_data_task(const std::shared_ptr<Table_chunking> &chunking,
+                              const std::size_t sub_range,
+                              Range_info &&range) {
+    std::lock_guard<std::mutex> lock(chunking->ranges_mutex);
+
+    if (sub_range == chunking->current_range) {
+      create_table_data_task(chunking, std::move(range), false);
+    } else {
+      chunking->held_chunks[sub_range].emplace_back(std::move(range));
+    }
+  }
+
+  void range_chunked(const std::shared_ptr<Table_chunking> &chunking,
+                     const std::size_t sub_range) {
+    bool all_chunked = false;
+
+    {
+      std::lock_guard<std::mutex> lock(chunking->ranges_mutex);
+      auto &current = chunking->current_range;
+      const auto ranges = chunking->chunked_ranges.size();
+
+      chunking->chunked_ranges[sub_range] = true;
+
+      // once the current sub-range is chunked, the held chunks of the next
+      // one get the following indexes
+      while (current < ranges && chunking->chunked_ranges[current]) {
+        if (++current < ranges) {
+          for (auto &range : chunking->held_chunks[current]) {
+            create_table_data_task(chunking, std::move(range), false);
+          }
+
+          chunking->held_chunks[current].clear();
+        }
+      }
+
+      all_chunked = current == ranges;
+
+      if (all_chunked) {
+        create_table_data_task(chunking, std::move(chunking->last_range),
+                               true);
+      }
+    }
+
+    if (all_chunked) {
+      table_data_tasks_created(chunking->task, chunking->next_index);
+    } else {
+      m_dumper->chunking_task_finished();
+    }
   }
 
   uint64_t get_average_row_length(const Table_task &task) const {
@@ -1237,6 +1523,14 @@ void Dumper::create_worker_threads() {
   m_worker_exceptions.clear();
   m_worker_exceptions.resize(m_options.threads());
   m_worker_synchronization = std::make_unique<Synchronize_workers>();
+  m_worker_tasks = std::make_unique<Worker_tasks>(m_options.threads());
+
+  if (compressed() && !is_dry_run()) {
+    // compression is offloaded to a separate pool, so workers can keep
+    // fetching data from the server
+    m_compression_pool =
+        std::make_unique<Compression_pool>(m_options.threads());
+  }
 
   for (std::size_t i = 0; i < m_options.threads(); ++i) {
     std::thread t(
@@ -1253,7 +1547,7 @@ void Dumper::wait_for_workers() {
 void Dumper::maybe_push_shutdown_tasks() {
   if (0 == m_chunking_tasks &&
       m_main_thread_finished_producing_chunking_tasks) {
-    m_worker_tasks.shutdown(m_workers.size());
+    m_worker_tasks->shutdown();
   }
 }
 
@@ -1268,6 +1562,12 @@ void Dumper::wait_for_all_tasks() {
   }
 
   m_workers.clear();
+
+  if (m_compression_pool) {
+    m_compression_pool->shutdown();
+    m_compression_pool.reset();
+  }
+
   m_worker_writers.clear();
 }
 
@@ -1425,19 +1725,24 @@ void Dumper::create_schema_ddl_tasks() {
   }
 
   for (const auto &schema : m_schema_tasks) {
-    m_worker_tasks.push(
-        [&schema](Table_worker *worker) { worker->dump_schema_ddl(schema); });
+    m_worker_tasks->push(
+        [&schema](Table_worker *worker) { worker->dump_schema_ddl(schema); },
+        Worker_tasks::Priority::MEDIUM);
 
     for (const auto &view : schema.views) {
-      m_worker_tasks.push([&schema, &view](Table_worker *worker) {
-        worker->dump_view_ddl(schema, view);
-      });
+      m_worker_tasks->push(
+          [&schema, &view](Table_worker *worker) {
+            worker->dump_view_ddl(schema, view);
+          },
+          Worker_tasks::Priority::MEDIUM);
     }
 
     for (auto &table : schema.tables) {
-      m_worker_tasks.push([&schema, &table](Table_worker *worker) {
-        worker->dump_table_ddl(schema, table);
-      });
+      m_worker_tasks->push(
+          [&schema, &table](Table_worker *worker) {
+            worker->dump_table_ddl(schema, table);
+          },
+          Worker_tasks::Priority::MEDIUM);
     }
   }
 }
@@ -1505,13 +1810,16 @@ void Dumper::create_table_task(const Schema_task &schema, Table_info *table) {
 
   Table_task task{schema.name,          table->name,     index,
                   table->primary_index, table->basename, table->row_count};
-  m_worker_tasks.push([task = std::move(task)](Table_worker *worker) {
-    ++worker->m_dumper->m_num_threads_chunking;
+  // chunking has the highest priority, largest tables are chunked first
+  m_worker_tasks->push(
+      [task = std::move(task)](Table_worker *worker) {
+        ++worker->m_dumper->m_num_threads_chunking;
 
-    worker->create_table_data_tasks(task);
+        worker->create_table_data_tasks(task);
 
-    --worker->m_dumper->m_num_threads_chunking;
-  });
+        --worker->m_dumper->m_num_threads_chunking;
+      },
+      Worker_tasks::Priority::HIGH, table->row_count);
 }
 
 std::string Dumper::choose_index(const Schema_task &schema,
@@ -1557,6 +1865,10 @@ Dump_writer *Dumper::get_table_data_writer(const std::string &filename) {
                                                 m_options.dialect());
   }
 
+  if (m_compression_pool) {
+    writer->set_compression_pool(m_compression_pool.get());
+  }
+
   m_worker_writers.emplace_back(std::move(writer));
 
   return m_worker_writers.back().get();
@@ -1936,10 +2248,8 @@ void Dumper::rethrow() const {
 void Dumper::emergency_shutdown() {
   m_worker_interrupt = true;
 
-  const auto workers = m_workers.size();
-
-  if (workers > 0) {
-    m_worker_tasks.shutdown(workers);
+  if (m_worker_tasks) {
+    m_worker_tasks->shutdown();
   }
 }
 
@@ -40,8 +40,8 @@
 #include "mysqlshdk/libs/storage/ifile.h"
 #include "mysqlshdk/libs/textui/text_progress.h"
 #include "mysqlshdk/libs/utils/nullable.h"
-#include "mysqlshdk/libs/utils/synchronized_queue.h"
 #include "mysqlshdk/libs/utils/version.h"
+#include "mysqlshdk/libs/utils/work_stealing_queue.h"
 
 #include "modules/util/dump/dump_options.h"
 #include "modules/util/dump/dump_writer.h"
@@ -52,6 +52,8 @@ class Schema_dumper;
 
 namespace dump {
 
+class Compression_pool;
+
 class Dumper {
  public:
   Dumper() = delete;
@@ -95,6 +97,8 @@ class Dumper {
     std::string begin;
     std::string end;
     mysqlshdk::db::Type type;
+    // range is [begin, end) instead of [begin, end]
+    bool end_exclusive = false;
   };
 
   struct Column_info {
@@ -102,6 +106,8 @@ class Dumper {
     bool csv_unsafe = false;
   };
 
+  struct Table_chunking;
+
   struct Table_data_task : Table_info {
     std::string schema;
     std::vector<Column_info> columns;
@@ -110,10 +116,14 @@ class Dumper {
     Dump_writer *writer = nullptr;
     std::unique_ptr<mysqlshdk::storage::IFile> index_file;
     std::string id;
+    std::shared_ptr<Table_chunking> chunking;
   };
 
   class Table_worker;
 
+  using Worker_tasks =
+      shcore::Work_stealing_queue<std::function<void(Table_worker *)>>;
+
   class Synchronize_workers;
 
   class Dump_info;
@@ -335,13 +345,13 @@ class Dumper {
   // threads
   std::vector<std::thread> m_workers;
   std::vector<std::exception_ptr> m_worker_exceptions;
-  shcore::Synchronized_queue<std::function<void(Table_worker *)>>
-      m_worker_tasks;
+  std::unique_ptr<Worker_tasks> m_worker_tasks;
   std::atomic<uint64_t> m_chunking_tasks;
   std::atomic<bool> m_main_thread_finished_producing_chunking_tasks;
   std::unique_ptr<Synchronize_workers> m_worker_synchronization;
   std::vector<std::unique_ptr<Dump_writer>> m_worker_writers;
   std::mutex m_worker_writers_mutex;
+  std::unique_ptr<Compression_pool> m_compression_pool;
   volatile bool m_worker_interrupt = false;
 };
 
@@ -31,7 +31,10 @@ namespace dump {
 Text_dump_writer::Text_dump_writer(
     std::unique_ptr<mysqlshdk::storage::IFile> out,
     const import_table::Dialect &dialect)
-    : Dump_writer(std::move(out)), m_dialect(dialect), m_escaped_characters() {
+    : Dump_writer(std::move(out)),
+      m_dialect(dialect),
+      m_escaped_characters(),
+      m_escape_table() {
   if (m_dialect.lines_terminated_by.empty()) {
     m_line_terminator = m_dialect.fields_terminated_by;
   } else {
@@ -64,6 +67,8 @@ Text_dump_writer::Text_dump_writer(
     } else {
       m_escaped_characters[idx++] = m_dialect.fields_enclosed_by[0];
     }
+
+    m_escape_table = create_escape_table(m_escaped_characters, idx);
   }
 }
 
@@ -75,10 +80,25 @@ void Text_dump_writer::store_preamble(
 }
 
 void Text_dump_writer::store_row(const mysqlshdk::db::IRow *row) {
+  const char *data = nullptr;
+  std::size_t length = 0;
+
+  start_row();
+
+  for (uint32_t idx = 0; idx < m_num_fields; ++idx) {
+    row->get_raw_data(idx, &data, &length);
+    store_field(data, length, idx);
+  }
+
+  finish_row();
+}
+
+void Text_dump_writer::store_row(const char *const *data,
+                                 const unsigned long *lengths) {
   start_row();
 
   for (uint32_t idx = 0; idx < m_num_fields; ++idx) {
-    store_field(row, idx);
+    store_field(data[idx], lengths[idx], idx);
   }
 
   finish_row();
@@ -127,7 +147,7 @@ void Text_dump_writer::start_row() {
   buffer()->append_fixed(m_dialect.lines_starting_by);
 }
 
-void Text_dump_writer::store_field(const mysqlshdk::db::IRow *row,
+void Text_dump_writer::store_field(const char *data, std::size_t length,
                                    uint32_t idx) {
   // TODO(pawel): implement a fixed-row format:
   //              https://dev.mysql.com/doc/refman/8.0/en/load-data.html
@@ -138,10 +158,6 @@ void Text_dump_writer::store_field(const mysqlshdk::db::IRow *row,
 
   quote_field(idx);
 
-  const char *data = nullptr;
-  std::size_t length = 0;
-  row->get_raw_data(idx, &data, &length);
-
   bool is_null = nullptr == data;
 
   if (!is_null) {
@@ -161,57 +177,7 @@ void Text_dump_writer::store_field(const mysqlshdk::db::IRow *row,
   } else {
     if (m_escape) {
       buffer()->will_write(2 * length);
-      const auto end = data + length;
-
-      for (auto p = data; p != end; ++p) {
-        const auto c = *p;
-        char to_write = 0;
-
-        // note: this doesn't produce output consistent with SELECT .. INTO
-        // OUTFILE (i.e. tabs are escaped), but LOAD DATA INFILE handles
-        // this correctly and escaping i.e. carriage return characters helps
-        // with readability
-
-        switch (c) {
-          case '\0':
-            to_write = '0';
-            break;
-
-          case '\b':
-            to_write = 'b';
-            break;
-
-          case '\n':
-            to_write = 'n';
-            break;
-
-          case '\r':
-            to_write = 'r';
-            break;
-
-          case '\t':
-            to_write = 't';
-            break;
-
-          case 0x1A:  // ASCII 26
-            to_write = 'Z';
-            break;
-
-          default:
-            if (c == m_escaped_characters[0] || c == m_escaped_characters[1] ||
-                c == m_escaped_characters[2]) {
-              to_write = c;
-            }
-            break;
-        }
-
-        if (0 != to_write) {
-          buffer()->append(m_escape_char);
-          buffer()->append(to_write);
-        } else {
-          buffer()->append(c);
-        }
-      }
+      buffer()->append_escaped(data, length, m_escape_char, m_escape_table);
     } else {
       buffer()->will_write(length);
       buffer()->append(data, length);
@@ -54,13 +54,16 @@ class Text_dump_writer : public Dump_writer {
 
   void store_row(const mysqlshdk::db::IRow *row) override;
 
+  void store_row(const char *const *data,
+                 const unsigned long *lengths) override;
+
   void store_postamble() override;
 
   void read_metadata(const std::vector<mysqlshdk::db::Column> &metadata);
 
   void start_row();
 
-  void store_field(const mysqlshdk::db::IRow *row, uint32_t idx);
+  void store_field(const char *data, std::size_t length, uint32_t idx);
 
   void quote_field(uint32_t idx);
 
@@ -80,6 +83,8 @@ class Text_dump_writer : public Dump_writer {
 
   char m_escape_char;
 
+  Escape_table m_escape_table;
+
   uint32_t m_num_fields;
 
   // not using vectors of bool here, as they are not very efficient on access
@@ -25,8 +25,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 
 #include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
 
 namespace mysqlsh {
 namespace import_table {
@@ -70,17 +72,7 @@ File_iterator::File_iterator(
 }
 
 File_iterator &File_iterator::operator++() {
-  ++m_offset;
-  ++m_ptr;
-
-  if (!(m_ptr < m_ptr_end)) {
-    await_next();
-    swap();
-    if (!m_eof) {
-      read_next(m_offset + m_current->size() - m_current->reserved);
-    }
-  }
-
+  advance(1);
   return *this;
 }
 
@@ -98,6 +90,88 @@ File_iterator &File_iterator::operator--(int) {
   return *this;
 }
 
+bool File_iterator::search(const char *needle, size_t needle_size,
+                           size_t last, Find_context<uint8_t> *context) {
+  assert(needle_size > 0);
+
+  if (m_offset < last && !(m_ptr < m_ptr_end)) {
+    // iterator points to the reserved area, move to the next buffer
+    advance(0);
+  }
+
+  const auto first_byte = static_cast<unsigned char>(needle[0]);
+
+  while (m_offset < last) {
+    // needle can start anywhere before the reserved area, the reserved bytes
+    // are loaded again at the beginning of the next buffer, but are valid here
+    // and can be used to compare the rest of the needle
+    const size_t available = std::min(static_cast<size_t>(m_ptr_end - m_ptr),
+                                      last - m_offset);
+    const uint8_t *const scan_end = m_ptr + available;
+    const uint8_t *const data_end =
+        std::min(m_current->end(), m_ptr + (last - m_offset));
+    const uint8_t *p = m_ptr;
+
+    while (p < scan_end) {
+      p = static_cast<const uint8_t *>(memchr(p, first_byte, scan_end - p));
+
+      if (nullptr == p) {
+        break;
+      }
+
+      if (static_cast<size_t>(data_end - p) >= needle_size &&
+          0 == memcmp(p + 1, needle + 1, needle_size - 1)) {
+        if (p != m_ptr) {
+          context->preceding_element_set = true;
+          context->preceding_element = *(p - 1);
+        }
+
+        context->last_element = *p;
+        context->needle_found = true;
+
+        // iterator may end up in the reserved area, so that it's still
+        // possible to step back to the needle
+        const size_t bytes = p - m_ptr + needle_size;
+        m_ptr += bytes;
+        m_offset += bytes;
+
+        return true;
+      }
+
+      ++p;
+    }
+
+    if (available > 0) {
+      context->preceding_element_set = true;
+      context->preceding_element = *(scan_end - 1);
+      context->last_element = *(scan_end - 1);
+    }
+
+    advance(available);
+  }
+
+  context->needle_found = false;
+  return false;
+}
+
+void File_iterator::advance(size_t bytes) {
+  m_offset += bytes;
+  m_ptr += bytes;
+
+  if (!(m_ptr < m_ptr_end)) {
+    const size_t past_end = m_ptr - m_ptr_end;
+
+    await_next();
+    swap();
+
+    if (!m_eof) {
+      read_next(m_current->offset + m_current->size() - m_current->reserved);
+    }
+
+    m_ptr += past_end;
+  }
+}
+
 void File_iterator::read_next(size_t offset) {
   m_aio->buffer = m_next->buffer;
   m_aio->offset = offset;
@@ -190,8 +264,27 @@ void Chunk_file::set_chunk_size(const size_t bytes) {
   m_chunk_size = std::max(bytes, min_bytes_per_chunk);
 }
 
-void Chunk_file::start() {
+namespace {
+
+/**
+ * Queue which passes the ranges to the consumer.
+ */
+class Range_consumer final {
+ public:
+  explicit Range_consumer(const std::function<void(Range &&)> &consumer)
+      : m_consumer(consumer) {}
+
+  void push(Range &&r) { m_consumer(std::move(r)); }
+
+ private:
+  const std::function<void(Range &&)> &m_consumer;
+};
+
+}  // namespace
+
+void Chunk_file::start(const std::function<void(Range &&)> &consumer) {
   File_handler fh{m_file_handle};
+  Range_consumer queue{consumer};
 
   const size_t needle_size = m_dialect.lines_terminated_by.size();
   auto first = fh.begin(needle_size);
@@ -203,14 +296,161 @@ void Chunk_file::start() {
                         m_skip_rows_count);
     }
     chunk_by_max_bytes(first, last, m_dialect.lines_terminated_by, m_chunk_size,
-                       m_queue);
+                       &queue);
   } else {
     if (m_skip_rows_count > 0) {
       first = skip_rows(first, last, m_dialect.lines_terminated_by,
                         m_skip_rows_count, m_dialect.fields_escaped_by[0]);
     }
     chunk_by_max_bytes(first, last, m_dialect.lines_terminated_by,
-                       m_dialect.fields_escaped_by[0], m_chunk_size, m_queue);
+                       m_dialect.fields_escaped_by[0], m_chunk_size, &queue);
+  }
+}
+
+Row_end_finder::Row_end_finder(const std::string &terminator,
+                               const std::string &escape)
+    : m_terminator(terminator),
+      m_escape(escape.empty() ? -1 : static_cast<unsigned char>(escape[0])) {}
+
+void Row_end_finder::reset() {
+  m_matched = 0;
+  m_last = k_row_start;
+}
+
+void Row_end_finder::skip(const char *data, size_t length) {
+  if (length > 0) {
+    m_matched = 0;
+    m_last = static_cast<unsigned char>(data[length - 1]);
+  }
+}
+
+bool Row_end_finder::find(const char *data, size_t length, size_t *out_end) {
+  assert(!m_terminator.empty());
+
+  for (size_t i = 0; i < length; ++i) {
+    const char c = data[i];
+
+    if (c != m_terminator[m_matched]) {
+      m_matched = 0;
+    }
+
+    if (c == m_terminator[m_matched]) {
+      if (0 == m_matched) {
+        m_before_match = m_last;
+      }
+
+      if (++m_matched == m_terminator.size()) {
+        m_matched = 0;
+
+        // terminator is escaped or escape state is unknown
+        const bool escaped = k_unknown == m_before_match ||
+                             (m_escape >= 0 && m_before_match == m_escape);
+
+        if (!escaped) {
+          m_last = static_cast<unsigned char>(c);
+          *out_end = i + 1;
+          return true;
+        }
+      }
+    }
+
+    m_last = static_cast<unsigned char>(c);
+  }
+
+  return false;
+}
+
+void Chunk_stream::set_chunk_size(const size_t bytes) {
+  constexpr const size_t min_bytes_per_chunk = 2 * BUFFER_SIZE;
+  m_chunk_size = std::max(bytes, min_bytes_per_chunk);
+}
+
+void Chunk_stream::start(
+    const std::function<bool(Data_block &&)> &consumer) {
+  assert(!m_dialect.lines_terminated_by.empty());
+
+  m_file_handle->open(mysqlshdk::storage::Mode::READ);
+  shcore::on_leave_scope close_file([this]() { m_file_handle->close(); });
+
+  Row_end_finder row_end{m_dialect.lines_terminated_by,
+                         m_dialect.fields_escaped_by};
+  row_end.reset();
+
+  uint64_t rows_to_skip = m_skip_rows_count;
+  std::string buffer(BUFFER_SIZE, '\0');
+  Data_block block;
+  // number of bytes of the current block which were passed to row_end
+  size_t searched = 0;
+
+  block.data.reserve(m_chunk_size + BUFFER_SIZE);
+
+  while (true) {
+    const auto bytes = m_file_handle->read(&buffer[0], buffer.size());
+
+    if (bytes < 0) {
+      throw std::runtime_error("Read error");
+    }
+
+    if (0 == bytes) {
+      break;
+    }
+
+    const char *data = buffer.data();
+    size_t size = static_cast<size_t>(bytes);
+
+    while (rows_to_skip > 0 && size > 0) {
+      size_t end = 0;
+
+      if (row_end.find(data, size, &end)) {
+        --rows_to_skip;
+      } else {
+        end = size;
+      }
+
+      data += end;
+      size -= end;
+      block.begin += end;
+    }
+
+    block.data.append(data, size);
+
+    while (block.data.size() >= m_chunk_size) {
+      if (searched < m_chunk_size) {
+        // block is not split before it reaches the requested size
+        row_end.skip(block.data.data() + searched, m_chunk_size - searched);
+        searched = m_chunk_size;
+      }
+
+      size_t end = 0;
+
+      if (!row_end.find(block.data.data() + searched,
+                        block.data.size() - searched, &end)) {
+        searched = block.data.size();
+        break;
+      }
+
+      end += searched;
+
+      Data_block next;
+      next.begin = block.begin + end;
+      next.data.reserve(m_chunk_size + BUFFER_SIZE);
+      next.data.append(block.data, end, std::string::npos);
+
+      block.data.resize(end);
+      block.end = next.begin;
+
+      if (!consumer(std::move(block))) {
+        return;
+      }
+
+      block = std::move(next);
+      searched = 0;
+    }
+  }
+
+  if (!block.data.empty()) {
+    block.end = block.begin + block.data.size();
+    consumer(std::move(block));
   }
 }
 
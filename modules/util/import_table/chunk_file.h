@@ -27,6 +27,7 @@
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <string>
 #include <thread>
@@ -93,6 +94,19 @@ struct Async_read_task {
   }
 };
 
+/**
+ * Stores find() function state for continuation
+ *
+ * @tparam T Underlying buffer value_type.
+ */
+template <typename T>
+struct Find_context {
+  bool needle_found = false;           //< Is needle found in haystack
+  bool preceding_element_set = false;  //< Is preceding_element valid
+  T preceding_element = T{};           //< Element before needle start
+  T last_element = T{};                //< Last visited element
+};
+
 /**
  * File_handler iterator that asynchronously pre-loads file chunks to double
  * buffer.
@@ -154,6 +168,23 @@ class File_iterator final {
    */
   File_iterator &operator--(int);
 
+  /**
+   * Searches for the first occurrence of the needle, whole buffers are
+   * scanned at once instead of advancing the iterator byte by byte. Sets the
+   * context in the same way as the generic find() does.
+   *
+   * @param needle Sequence of bytes to search for.
+   * @param needle_size Size of the needle, must not be greater than the size
+   * of the area reserved at the end of the buffer.
+   * @param last Offset where search ends.
+   * @param context Search state.
+   *
+   * @return true if needle was found, iterator is then positioned one past the
+   * needle, otherwise it is positioned at last.
+   */
+  bool search(const char *needle, size_t needle_size, size_t last,
+              Find_context<uint8_t> *context);
+
   /**
    * Get iterator position from file beginning.
    *
@@ -195,13 +226,23 @@ class File_iterator final {
    */
   void await_next();
 
+  /**
+   * Moves the iterator forward by the given number of bytes, loads the next
+   * file chunk if end of the buffer is reached. Iterator may point to the
+   * reserved buffer area, it is then moved to the same position in the next
+   * buffer.
+   *
+   * @param bytes Number of bytes to advance.
+   */
+  void advance(size_t bytes);
+
   /**
    * Swap double buffers and reset internal range pointers to proper values.
    */
   void swap() {
     std::swap(m_current, m_next);
     m_ptr = m_current->begin();
-    if (m_offset + m_current->size() < m_file_size) {
+    if (m_current->offset + m_current->size() < m_file_size) {
       m_ptr_end = m_current->begin() + m_current->size() - m_current->reserved;
     } else {
       m_ptr_end = m_current->begin() + m_current->size();
@@ -246,19 +287,6 @@ struct Range {
   size_t end;
 };
 
-/**
- * Stores find() function state for continuation
- *
- * @tparam T Underlying buffer value_type.
- */
-template <typename T>
-struct Find_context {
-  bool needle_found = false;           //< Is needle found in haystack
-  bool preceding_element_set = false;  //< Is preceding_element valid
-  T preceding_element = T{};           //< Element before needle start
-  T last_element = T{};                //< Last visited element
-};
-
 /**
  * Searches for an element equal to needle.
  *
@@ -328,6 +356,29 @@ ForwardIt find(ForwardIt first, ForwardIt last, ForwardIt2 needle_first,
   }
 }
 
+/**
+ * Searches for the first occurrence of the needle in the file, scans whole
+ * buffers using memchr().
+ *
+ * @param first Iterator to the first element of range to examine.
+ * @param last Iterator to the last element of range to examine.
+ * @param needle_first Iterator to first element of range to search for.
+ * @param needle_last Iterator to last element of range to search for.
+ * @return Returns one past first element from range [first, last) that
+ * satisfies search criteria, with character before matching needle and boolean
+ * flag indicating if needle was found.
+ */
+inline File_iterator find(File_iterator first, File_iterator last,
+                          std::string::const_iterator needle_first,
+                          std::string::const_iterator needle_last,
+                          Find_context<uint8_t> *context) {
+  assert(context);
+  assert(needle_first != needle_last);
+  first.search(&*needle_first, needle_last - needle_first, last.offset(),
+               context);
+  return first;
+}
+
 /**
  * Skip count lines/rows delimited by needle.
  *
@@ -501,19 +552,120 @@ class Chunk_file final {
   void set_file_handle(mysqlshdk::storage::IFile *fh) { m_file_handle = fh; }
   void set_dialect(const Dialect &dialect) { m_dialect = dialect; }
   void set_rows_to_skip(const size_t rows) { m_skip_rows_count = rows; }
-  void set_output_queue(shcore::Synchronized_queue<Range> *queue) {
-    m_queue = queue;
-  }
-  void start();
+
+  /**
+   * Splits the whole file, each range is passed to the consumer as soon as it
+   * is found.
+   *
+   * @param consumer Receives the ranges.
+   */
+  void start(const std::function<void(Range &&)> &consumer);
 
  private:
   size_t m_chunk_size = 2 * BUFFER_SIZE;
   Dialect m_dialect;
   uint64_t m_skip_rows_count = 0;
-  shcore::Synchronized_queue<Range> *m_queue = nullptr;
   mysqlshdk::storage::IFile *m_file_handle;
 };
 
+/**
+ * Finds ends of rows in a stream of data. Row ends with a line terminator
+ * which is not preceded by the escape character, the same rules are used when
+ * a file is split into chunks.
+ */
+class Row_end_finder final {
+ public:
+  Row_end_finder() = default;
+  Row_end_finder(const std::string &terminator, const std::string &escape);
+
+  Row_end_finder(const Row_end_finder &other) = default;
+  Row_end_finder(Row_end_finder &&other) = default;
+
+  Row_end_finder &operator=(const Row_end_finder &other) = default;
+  Row_end_finder &operator=(Row_end_finder &&other) = default;
+
+  ~Row_end_finder() = default;
+
+  /**
+   * Marks the beginning of the data, terminator which follows is not escaped.
+   */
+  void reset();
+
+  /**
+   * Passes over the data without searching it.
+   */
+  void skip(const char *data, size_t length);
+
+  /**
+   * Searches for the end of a row, state is kept between the calls, so the
+   * line terminator can span multiple buffers.
+   *
+   * @param data Data to search.
+   * @param length Length of the data.
+   * @param out_end Set to the offset one past the line terminator.
+   *
+   * @returns true if end of the row was found.
+   */
+  bool find(const char *data, size_t length, size_t *out_end);
+
+ private:
+  std::string m_terminator;
+  static constexpr int k_unknown = -1;
+  static constexpr int k_row_start = -2;
+
+  int m_escape = -1;
+  size_t m_matched = 0;
+  int m_last = k_unknown;
+  int m_before_match = k_unknown;
+};
+
+/**
+ * Row-aligned block of the imported data, loaded by a single worker. Block
+ * which is empty and does not span the whole file marks the end of the data.
+ */
+struct Data_block {
+  size_t file = 0;          //< Index of the imported file
+  size_t begin = 0;         //< Offset of the block in the (decompressed) file
+  size_t end = 0;           //< Offset one past the end of the block
+  std::string data;         //< Data of the block, if it was already read
+  bool whole_file = false;  //< Whole file is loaded, offsets are not used
+};
+
+/**
+ * Splits data read sequentially from a file (i.e. a compressed one, which
+ * cannot be read at random offsets) into row-aligned blocks.
+ */
+class Chunk_stream final {
+ public:
+  Chunk_stream() = default;
+  Chunk_stream(const Chunk_stream &other) = default;
+  Chunk_stream(Chunk_stream &&other) = default;
+
+  Chunk_stream &operator=(const Chunk_stream &other) = default;
+  Chunk_stream &operator=(Chunk_stream &&other) = default;
+
+  ~Chunk_stream() = default;
+
+  void set_chunk_size(const size_t bytes);
+  void set_file_handle(mysqlshdk::storage::IFile *fh) { m_file_handle = fh; }
+  void set_dialect(const Dialect &dialect) { m_dialect = dialect; }
+  void set_rows_to_skip(const size_t rows) { m_skip_rows_count = rows; }
+
+  /**
+   * Reads the whole file, each block is passed to the consumer as soon as it
+   * is complete.
+   *
+   * @param consumer Receives the blocks, returns false to stop reading.
+   */
+  void start(const std::function<bool(Data_block &&)> &consumer);
+
+ private:
+  size_t m_chunk_size = 2 * BUFFER_SIZE;
+  Dialect m_dialect;
+  uint64_t m_skip_rows_count = 0;
+  mysqlshdk::storage::IFile *m_file_handle = nullptr;
+};
+
 }  // namespace import_table
 }  // namespace mysqlsh
 
@@ -24,6 +24,7 @@
 #include "modules/util/import_table/import_table.h"
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
 #include <utility>
 
@@ -42,6 +43,8 @@ namespace import_table {
 Import_table::Import_table(const Import_table_options &options)
     : m_console(std::make_shared<dump::Console_with_progress>(m_progress,
                                                               &m_output_mutex)),
+      // at most two blocks of decompressed data per thread are kept in memory
+      m_block_budget(2 * options.threads_size() * options.bytes_per_chunk()),
       m_opt(options) {
   m_thread_exception.resize(options.threads_size(), nullptr);
 
@@ -88,29 +91,120 @@ void Import_table::progress_shutdown() {
 void Import_table::spawn_workers() {
   for (int64_t i = 0; i < m_opt.threads_size(); i++) {
     Load_data_worker worker(m_opt, i, m_progress.get(), &m_output_mutex,
-                            &m_prog_sent_bytes, m_interrupt, &m_range_queue,
+                            &m_prog_sent_bytes, m_interrupt, nullptr,
                             &m_thread_exception, &m_stats);
-    std::thread t(&Load_data_worker::operator(), std::move(worker));
+    worker.set_block_queue(&m_block_queue, &m_block_budget);
+
+    ++m_running_workers;
+
+    std::thread t([this, worker]() mutable {
+      worker();
+      --m_running_workers;
+    });
     m_threads.emplace_back(std::move(t));
   }
 }
 
-void Import_table::chunk_file() {
+bool Import_table::stopped() const {
+  return *m_interrupt || 0 == m_running_workers;
+}
+
+void Import_table::chunk_file(size_t file) {
+  const auto file_size = m_opt.file_size(file);
+
+  if (0 == m_opt.skip_rows_count() && file_size <= m_opt.bytes_per_chunk()) {
+    // small file is loaded as a whole, there's no need to read it
+    if (file_size > 0) {
+      Data_block block;
+      block.file = file;
+      block.end = file_size;
+      m_block_queue.push(std::move(block));
+    }
+
+    return;
+  }
+
+  const auto fh = m_opt.create_file_handle(file);
+
   Chunk_file chunk;
   chunk.set_chunk_size(m_opt.bytes_per_chunk());
-  chunk.set_file_handle(m_opt.file_handle());
+  chunk.set_file_handle(fh.get());
   chunk.set_dialect(m_opt.dialect());
   chunk.set_rows_to_skip(m_opt.skip_rows_count());
-  chunk.set_output_queue(&m_range_queue);
-  chunk.start();
+  chunk.start([this, file](Range &&r) {
+    Data_block block;
+    block.file = file;
+    block.begin = r.begin;
+    block.end = r.end;
+    m_block_queue.push(std::move(block));
+  });
+}
 
-  m_range_queue.shutdown(m_opt.threads_size());
+void Import_table::chunk_stream(size_t file) {
+  if (m_opt.dialect().lines_terminated_by.empty()) {
+    // rows cannot be found, whole file is decompressed by a single worker
+    Data_block block;
+    block.file = file;
+    block.whole_file = true;
+    m_block_queue.push(std::move(block));
+    return;
+  }
+
+  const auto fh = m_opt.create_file_handle(file);
+
+  Chunk_stream chunk;
+  chunk.set_chunk_size(m_opt.bytes_per_chunk());
+  chunk.set_file_handle(fh.get());
+  chunk.set_dialect(m_opt.dialect());
+  chunk.set_rows_to_skip(m_opt.skip_rows_count());
+  chunk.start([this, file](Data_block &&block) {
+    // wait until the workers load enough of the decompressed data
+    while (!m_block_budget.acquire(block.data.size(),
+                                   std::chrono::milliseconds(100))) {
+      if (stopped()) {
+        return false;
+      }
+    }
+
+    block.file = file;
+    m_block_queue.push(std::move(block));
+
+    return !*m_interrupt;
+  });
+}
+
+void Import_table::chunk_files() {
+  // chunks of all the files are loaded by the same workers, next file is
+  // split while chunks of the previous ones are being loaded
+  for (size_t i = 0; i < m_opt.files_count() && !stopped(); ++i) {
+    if (mysqlshdk::storage::Compression::NONE == m_opt.compression(i)) {
+      chunk_file(i);
+    } else {
+      // compressed file cannot be read at random offsets
+      chunk_stream(i);
+    }
+  }
+
+  m_block_queue.shutdown(m_opt.threads_size());
 }
 
 void Import_table::import() {
   m_timer.stage_begin("Parallel load data");
   spawn_workers();
-  chunk_file();
+
+  try {
+    chunk_files();
+  } catch (...) {
+    // i.e. compressed file is corrupted, workers need to be stopped before
+    // they can be joined
+    *m_interrupt = true;
+    m_block_queue.shutdown(m_opt.threads_size());
+    join_workers();
+    m_timer.stage_end();
+    progress_shutdown();
+    throw;
+  }
+
   join_workers();
   m_timer.stage_end();
   progress_shutdown();
@@ -121,9 +215,12 @@ std::string Import_table::import_summary() const {
   using mysqlshdk::utils::format_seconds;
   using mysqlshdk::utils::format_throughput_bytes;
   const auto filesize = m_opt.file_size();
+  const auto files = m_opt.files_count();
   return std::string{
-      "File '" + m_opt.full_path() + "' (" + format_bytes(filesize) +
-      ") was imported in " + format_seconds(m_timer.total_seconds_elapsed()) +
+      (1 == files ? "File '" + m_opt.full_path() + "' ("
+                  : std::to_string(files) + " files (") +
+      format_bytes(filesize) + (1 == files ? ") was" : ") were") +
+      " imported in " + format_seconds(m_timer.total_seconds_elapsed()) +
       " at " +
       format_throughput_bytes(filesize, m_timer.total_seconds_elapsed())};
 }
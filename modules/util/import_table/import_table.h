@@ -35,6 +35,7 @@
 #include "modules/util/import_table/import_table_options.h"
 #include "mysqlshdk/include/shellcore/scoped_contexts.h"
 #include "mysqlshdk/libs/textui/text_progress.h"
+#include "mysqlshdk/libs/utils/memory_budget.h"
 #include "mysqlshdk/libs/utils/profiling.h"
 #include "mysqlshdk/libs/utils/synchronized_queue.h"
 
@@ -80,7 +81,10 @@ class Import_table final {
  private:
   void spawn_workers();
   void join_workers();
-  void chunk_file();
+  bool stopped() const;
+  void chunk_file(size_t file);
+  void chunk_stream(size_t file);
+  void chunk_files();
   void progress_shutdown();
 
   std::atomic<size_t> m_prog_sent_bytes{0};
@@ -88,7 +92,9 @@ class Import_table final {
   std::mutex m_output_mutex;
   Scoped_console m_console;
 
-  shcore::Synchronized_queue<Range> m_range_queue;
+  shcore::Synchronized_queue<Data_block> m_block_queue;
+  mysqlshdk::utils::Memory_budget m_block_budget;
+  std::atomic<int64_t> m_running_workers{0};
 
   const Import_table_options &m_opt;
   Stats m_stats;
@@ -37,21 +37,39 @@
 #include "mysqlshdk/libs/oci/oci_options.h"
 #include "mysqlshdk/libs/storage/backend/oci_object_storage.h"
 #include "mysqlshdk/libs/storage/compressed_file.h"
+#include "mysqlshdk/libs/storage/idirectory.h"
 #include "mysqlshdk/libs/storage/ifile.h"
 #include "mysqlshdk/libs/utils/strformat.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/libs/utils/utils_path.h"
 
 namespace mysqlsh {
 namespace import_table {
 
+namespace {
+
+mysqlshdk::storage::Compression compression_from_path(const std::string &path) {
+  try {
+    return mysqlshdk::storage::from_extension(
+        std::get<1>(shcore::path::split_extension(path)));
+  } catch (...) {
+    return mysqlshdk::storage::Compression::NONE;
+  }
+}
+
+}  // namespace
+
 Import_table_options::Import_table_options(const std::string &filename,
                                            const shcore::Dictionary_t &options)
-    : m_filename(filename),
+    : Import_table_options(std::vector<std::string>{filename}, options) {}
+
+Import_table_options::Import_table_options(
+    const std::vector<std::string> &filenames,
+    const shcore::Dictionary_t &options)
+    : m_filenames(filenames),
       m_oci_options(
           mysqlshdk::oci::Oci_options::Unpack_target::OBJECT_STORAGE) {
-  m_table = std::get<0>(
-      shcore::path::split_extension(shcore::path::basename(filename)));
   unpack(options);
 }
 
@@ -64,6 +82,17 @@ Import_table_options::Import_table_options(const shcore::Dictionary_t &options)
 void Import_table_options::validate() {
   m_dialect.validate();
 
+  if (!m_max_bytes_per_transaction.empty()) {
+    constexpr size_t min_bytes_per_transaction = 4096;
+
+    if (max_bytes_per_transaction() < min_bytes_per_transaction) {
+      throw std::invalid_argument(
+          "The value of 'maxBytesPerTransaction' option must be greater than "
+          "or equal to " +
+          std::to_string(min_bytes_per_transaction) + " bytes.");
+    }
+  }
+
   if (m_schema.empty()) {
     auto res = m_base_session->query("SELECT schema()");
     auto row = res->fetch_one_or_throw();
@@ -89,39 +118,118 @@ void Import_table_options::validate() {
     }
   }
 
-  if (!m_filename.empty() || m_oci_options) {
-    mysqlshdk::oci::parse_oci_options(mysqlshdk::oci::Oci_uri_type::FILE,
-                                      m_filename, {}, &m_oci_options,
-                                      &m_filename);
+  if (!m_filenames.empty()) {
+    m_files.clear();
+    m_file_size = 0;
+
+    for (const auto &filename : m_filenames) {
+      add_files(filename);
+    }
+
+    if (m_files.empty()) {
+      throw std::invalid_argument("No files to import.");
+    }
+
+    if (m_table.empty()) {
+      m_table = std::get<0>(shcore::path::split_extension(
+          shcore::path::basename(m_files[0].path)));
+    }
 
-    m_file_handle = create_file_handle();
-    m_file_handle->open(mysqlshdk::storage::Mode::READ);
-    m_full_path = m_file_handle->full_path();
-    m_file_size = m_file_handle->file_size();
-    m_file_handle->close();
     m_threads_size = calc_thread_size();
   }
 }
 
+void Import_table_options::add_files(const std::string &filename) {
+  File file;
+  file.oci_options = m_oci_options;
+
+  mysqlshdk::oci::parse_oci_options(mysqlshdk::oci::Oci_uri_type::FILE,
+                                    filename, {}, &file.oci_options,
+                                    &file.path);
+
+  const auto add_file = [this](File &&f) {
+    const auto handle = create_file_handle(f);
+    handle->open(mysqlshdk::storage::Mode::READ);
+    f.full_path = handle->full_path();
+    f.size = handle->file_size();
+    handle->close();
+
+    m_file_size += f.size;
+    m_files.emplace_back(std::move(f));
+  };
+
+  const auto pattern = shcore::path::basename(file.path);
+
+  if (std::string::npos == pattern.find_first_of("*?")) {
+    add_file(std::move(file));
+    return;
+  }
+
+  // wildcards are allowed only in the name of the file
+  auto directory = file.path.substr(0, file.path.size() - pattern.size());
+
+  if (directory.size() > 1) {
+    // strip the trailing separator
+    directory.pop_back();
+  }
+
+  const auto dir = mysqlshdk::storage::make_directory(
+      directory.empty() && !file.oci_options ? "." : directory,
+      file.oci_options);
+
+  if (!dir->exists()) {
+    throw std::invalid_argument("Directory " + dir->full_path() +
+                                " does not exist.");
+  }
+
+  // files which start with the literal part of the pattern
+  const auto prefix = pattern.substr(0, pattern.find_first_of("*?"));
+  auto matching = dir->filter_files({prefix});
+
+  matching.erase(std::remove_if(matching.begin(), matching.end(),
+                                [&pattern](const auto &f) {
+                                  return !shcore::match_glob(pattern, f.name,
+                                                             true);
+                                }),
+                 matching.end());
+
+  // files are imported in a predictable order
+  std::sort(matching.begin(), matching.end(),
+            [](const auto &l, const auto &r) { return l.name < r.name; });
+
+  for (const auto &m : matching) {
+    File f;
+    f.oci_options = file.oci_options;
+    f.path = directory.empty()
+                 ? m.name
+                 : file.oci_options ? directory + "/" + m.name
+                                    : dir->join_path(directory, m.name);
+    add_file(std::move(f));
+  }
+}
+
+std::unique_ptr<mysqlshdk::storage::IFile>
+Import_table_options::create_file_handle(size_t file) const {
+  return create_file_handle(m_files[file]);
+}
+
 std::unique_ptr<mysqlshdk::storage::IFile>
-Import_table_options::create_file_handle() const {
+Import_table_options::create_file_handle(const File &f) const {
   std::unique_ptr<mysqlshdk::storage::IFile> file;
 
-  if (!m_oci_options.os_bucket_name.is_null()) {
-    file = mysqlshdk::storage::make_file(m_filename, m_oci_options);
+  if (!f.oci_options.os_bucket_name.is_null()) {
+    file = mysqlshdk::storage::make_file(f.path, f.oci_options);
   } else {
-    file = mysqlshdk::storage::make_file(m_filename);
+    file = mysqlshdk::storage::make_file(f.path);
   }
 
-  mysqlshdk::storage::Compression compr;
-  try {
-    compr = mysqlshdk::storage::from_extension(
-        std::get<1>(shcore::path::split_extension(m_filename)));
-  } catch (...) {
-    compr = mysqlshdk::storage::Compression::NONE;
-  }
+  return mysqlshdk::storage::make_file(std::move(file),
+                                       compression_from_path(f.path));
+}
 
-  return mysqlshdk::storage::make_file(std::move(file), compr);
+mysqlshdk::storage::Compression Import_table_options::compression(
+    size_t file) const {
+  return compression_from_path(m_files[file].path);
 }
 
 size_t Import_table_options::calc_thread_size() {
@@ -129,7 +237,20 @@ size_t Import_table_options::calc_thread_size() {
   int64_t threads_size = std::max(static_cast<int64_t>(1), m_threads_size);
 
   // We do not need to spawn more threads than file chunks
-  const size_t calculated_threads = (m_file_size / bytes_per_chunk()) + 1;
+  size_t calculated_threads = 0;
+
+  for (size_t i = 0; i < m_files.size(); ++i) {
+    if (mysqlshdk::storage::Compression::NONE == compression(i)) {
+      calculated_threads += (m_files[i].size / bytes_per_chunk()) + 1;
+    } else if (m_dialect.lines_terminated_by.empty()) {
+      // decompressed stream cannot be split
+      ++calculated_threads;
+    } else {
+      // size of the decompressed data is not known upfront
+      return threads_size;
+    }
+  }
+
   if (calculated_threads <
       static_cast<size_t>(std::numeric_limits<int64_t>::max())) {
     threads_size =
@@ -174,11 +295,20 @@ size_t Import_table_options::bytes_per_chunk() const {
                   min_bytes_per_chunk);
 }
 
+size_t Import_table_options::max_bytes_per_transaction() const {
+  if (!m_max_bytes_per_transaction.empty()) {
+    return mysqlshdk::utils::expand_to_bytes(m_max_bytes_per_transaction);
+  }
+  return 0;
+}
+
 std::string Import_table_options::target_import_info() const {
   auto connection_options = m_base_session->get_connection_options();
   std::string info_msg =
-      "Importing from file '" + full_path() + "' to table `" + schema() +
-      "`.`" + table() + "` in MySQL Server at " +
+      "Importing from " +
+      (1 == files_count() ? "file '" + full_path() + "'"
+                          : std::to_string(files_count()) + " files") +
+      " to table `" + schema() + "`.`" + table() + "` in MySQL Server at " +
       connection_options.as_uri(mysqlshdk::db::uri::formats::only_transport()) +
       " using " + std::to_string(threads_size());
   info_msg += threads_size() == 1 ? " thread" : " threads";
@@ -200,6 +330,7 @@ void Import_table_options::unpack(const shcore::Dictionary_t &options) {
       .optional("columns", &m_columns)
       .optional("replaceDuplicates", &m_replace_duplicates)
       .optional("maxRate", &m_max_rate)
+      .optional("maxBytesPerTransaction", &m_max_bytes_per_transaction)
       .optional("showProgress", &m_show_progress)
       .optional("skipRows", &m_skip_rows_count)
       .optional("decodeColumns", &decode_columns)
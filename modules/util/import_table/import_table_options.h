@@ -37,7 +37,9 @@
 #include "mysqlshdk/libs/db/connection_options.h"
 #include "mysqlshdk/libs/db/mysql/session.h"
 #include "mysqlshdk/libs/oci/oci_options.h"
+#include "mysqlshdk/libs/storage/compressed_file.h"
 #include "mysqlshdk/libs/storage/ifile.h"
+#include "mysqlshdk/libs/utils/memory_budget.h"
 
 namespace mysqlsh {
 namespace import_table {
@@ -53,6 +55,9 @@ class Import_table_options {
   Import_table_options(const std::string &filename,
                        const shcore::Dictionary_t &options);
 
+  Import_table_options(const std::vector<std::string> &filenames,
+                       const shcore::Dictionary_t &options);
+
   Import_table_options(const Import_table_options &other) = delete;
   Import_table_options(Import_table_options &&other) = default;
 
@@ -71,9 +76,14 @@ class Import_table_options {
 
   Connection_options connection_options() const;
 
-  const std::string &filename() const { return m_filename; }
+  /**
+   * Number of files to be imported, known once options are validated.
+   */
+  size_t files_count() const { return m_files.size(); }
 
-  const std::string &full_path() const { return m_full_path; }
+  const std::string &full_path(size_t file = 0) const {
+    return m_files[file].full_path;
+  }
 
   size_t max_rate() const;
 
@@ -81,6 +91,14 @@ class Import_table_options {
 
   void set_replace_duplicates(bool flag) { m_replace_duplicates = flag; }
 
+  mysqlshdk::utils::Memory_budget *memory_budget() const {
+    return m_memory_budget;
+  }
+
+  void set_memory_budget(mysqlshdk::utils::Memory_budget *budget) {
+    m_memory_budget = budget;
+  }
+
   const std::vector<std::string> &columns() const { return m_columns; }
 
   const std::map<std::string, std::string> &decode_columns() const {
@@ -99,32 +117,52 @@ class Import_table_options {
 
   const std::string &character_set() const { return m_character_set; }
 
+  /**
+   * Total size of all the imported files.
+   */
   size_t file_size() const { return m_file_size; }
 
+  size_t file_size(size_t file) const { return m_files[file].size; }
+
   size_t bytes_per_chunk() const;
 
+  size_t max_bytes_per_transaction() const;
+
   std::string target_import_info() const;
 
   mysqlshdk::oci::Oci_options get_oci_options() const { return m_oci_options; }
 
   /**
-   * Returns the raw pointer to the file handle
+   * Creates a new handle to the given file using the provided options.
    */
-  mysqlshdk::storage::IFile *file_handle() const { return m_file_handle.get(); }
+  std::unique_ptr<mysqlshdk::storage::IFile> create_file_handle(
+      size_t file = 0) const;
 
   /**
-   * Creates a new file handle using the provided options.
+   * Compression of the given file, detected using its extension.
    */
-  std::unique_ptr<mysqlshdk::storage::IFile> create_file_handle() const;
+  mysqlshdk::storage::Compression compression(size_t file = 0) const;
 
  private:
+  struct File {
+    std::string path;  //< Path to the file, name of object in case of OCI
+    mysqlshdk::oci::Oci_options oci_options;
+    std::string full_path;
+    size_t size = 0;
+  };
+
   void unpack(const shcore::Dictionary_t &options);
 
+  void add_files(const std::string &filename);
+
+  std::unique_ptr<mysqlshdk::storage::IFile> create_file_handle(
+      const File &file) const;
+
   size_t calc_thread_size();
 
-  std::string m_filename;
-  std::string m_full_path;
-  size_t m_file_size;
+  std::vector<std::string> m_filenames;
+  std::vector<File> m_files;
+  size_t m_file_size = 0;
   std::string m_table;
   std::string m_schema;
   std::string m_character_set;
@@ -134,12 +172,13 @@ class Import_table_options {
   std::map<std::string, std::string> m_decode_columns;
   bool m_replace_duplicates = false;
   std::string m_max_rate;
+  std::string m_max_bytes_per_transaction;
   bool m_show_progress = isatty(fileno(stdout)) ? true : false;
   uint64_t m_skip_rows_count = 0;
   Dialect m_dialect;
   mysqlshdk::oci::Oci_options m_oci_options;
   std::shared_ptr<mysqlshdk::db::mysql::Session> m_base_session;
-  std::unique_ptr<mysqlshdk::storage::IFile> m_file_handle;
+  mysqlshdk::utils::Memory_budget *m_memory_budget = nullptr;
 };
 
 }  // namespace import_table
@@ -39,19 +39,29 @@ using off64_t = off_t;
 
 #include <mysql.h>
 #include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include "modules/util/import_table/helpers.h"
 #include "mysqlshdk/include/shellcore/console.h"
 #include "mysqlshdk/include/shellcore/shell_init.h"
 #include "mysqlshdk/libs/rest/error.h"
+#include "mysqlshdk/libs/storage/backend/http.h"
+#include "mysqlshdk/libs/storage/backend/memory_file.h"
+#include "mysqlshdk/libs/storage/backend/oci_object_storage.h"
 #include "mysqlshdk/libs/storage/compressed_file.h"
+#include "mysqlshdk/libs/storage/read_ahead_file.h"
 #include "mysqlshdk/libs/utils/utils_path.h"
 #include "mysqlshdk/libs/utils/utils_string.h"
 
 namespace mysqlsh {
 namespace import_table {
 namespace {
+
+// number of bytes which are read ahead of the LOAD DATA statement
+constexpr size_t k_read_ahead_size = 8 * 1024 * 1024;
+
 int local_infile_init_nop(void ** /* buffer */, const char *filename,
                           void * /* userdata */) {
   mysqlsh::current_console()->print_error(
@@ -71,27 +81,44 @@ int local_infile_error_nop(void * /* userdata */, char * /* error_msg */,
                            unsigned int /* error_msg_len */) {
   return CR_LOAD_DATA_LOCAL_INFILE_REJECTED;
 }
+
+// file is downloaded or decompressed while it's being read
+bool is_slow_to_read(mysqlshdk::storage::IFile *file) {
+  return dynamic_cast<mysqlshdk::storage::Compressed_file *>(file) ||
+         dynamic_cast<mysqlshdk::storage::backend::Http_get *>(file) ||
+         dynamic_cast<mysqlshdk::storage::backend::oci::Object *>(file);
+}
 }  // namespace
 
 int local_infile_init(void **buffer, const char * /* filename */,
                       void *userdata) {
   File_info *file_info = static_cast<File_info *>(userdata);
-  // todo(kg): we can get rid of file open and close (in local_infile_end()).
-  //           We can open it when constructing File_info object.
-  try {
-    file_info->filehandler->open(mysqlshdk::storage::Mode::READ);
-  } catch (const std::runtime_error &ex) {
-    mysqlsh::current_console()->print_error(ex.what());
-    return 1;
-  }
 
-  if (file_info->range_read) {
-    off64_t offset = file_info->filehandler->seek(file_info->chunk_start);
-    if (offset == static_cast<off64_t>(-1)) {
+  if (file_info->continuation) {
+    // file is still open, continue where the previous LOAD DATA has stopped
+    file_info->continuation = false;
+  } else {
+    // todo(kg): we can get rid of file open and close (in
+    //           local_infile_end()). We can open it when constructing
+    //           File_info object.
+    try {
+      file_info->filehandler->open(mysqlshdk::storage::Mode::READ);
+    } catch (const std::runtime_error &ex) {
+      mysqlsh::current_console()->print_error(ex.what());
       return 1;
     }
+
+    if (file_info->range_read) {
+      off64_t offset = file_info->filehandler->seek(file_info->chunk_start);
+      if (offset == static_cast<off64_t>(-1)) {
+        return 1;
+      }
+    }
   }
 
+  file_info->transaction_bytes = 0;
+  file_info->transaction_done = false;
+
   *buffer = file_info;
 
   file_info->rate_limit = mysqlshdk::utils::Rate_limit(file_info->max_rate);
@@ -101,8 +128,17 @@ int local_infile_init(void **buffer, const char * /* filename */,
 int local_infile_read(void *userdata, char *buffer, unsigned int length) {
   File_info *file_info = static_cast<File_info *>(userdata);
 
+  if (file_info->transaction_done) {
+    // end of data for the current LOAD DATA statement
+    return 0;
+  }
+
   ssize_t bytes;
-  if (file_info->range_read) {
+  if (!file_info->pending.empty()) {
+    bytes = std::min(static_cast<size_t>(length), file_info->pending.size());
+    memcpy(buffer, file_info->pending.data(), bytes);
+    file_info->pending.erase(0, bytes);
+  } else if (file_info->range_read) {
     size_t len = std::min({static_cast<size_t>(length), file_info->bytes_left});
 
     bytes = file_info->filehandler->read(buffer, len);
@@ -114,6 +150,43 @@ int local_infile_read(void *userdata, char *buffer, unsigned int length) {
     if (bytes == -1) return bytes;
   }
 
+  if (file_info->max_transaction_size > 0 && bytes > 0) {
+    // once enough data was sent, end the statement at the end of a row, data
+    // which follows is sent by the next statement
+    const size_t size = static_cast<size_t>(bytes);
+    const size_t begin =
+        file_info->transaction_bytes < file_info->max_transaction_size
+            ? std::min(size, file_info->max_transaction_size -
+                                 file_info->transaction_bytes)
+            : 0;
+    size_t end = 0;
+
+    file_info->row_end.skip(buffer, begin);
+
+    if (file_info->row_end.find(buffer + begin, size - begin, &end)) {
+      end += begin;
+
+      file_info->pending.insert(0, buffer + end, size - end);
+      bytes = end;
+
+      if (file_info->pending.empty() && !file_info->range_read) {
+        // check if there's more data, there's no point in starting a new
+        // statement otherwise
+        file_info->pending.resize(length);
+        const auto next =
+            file_info->filehandler->read(&file_info->pending[0], length);
+        if (next == -1) return next;
+        file_info->pending.resize(next);
+      }
+
+      file_info->transaction_done =
+          !file_info->pending.empty() ||
+          (file_info->range_read && file_info->bytes_left > 0);
+    }
+
+    file_info->transaction_bytes += bytes;
+  }
+
   *(file_info->prog_bytes) += bytes;
   file_info->bytes += bytes;
 
@@ -149,7 +222,12 @@ void local_infile_end(void *userdata) {
     }
   }
 
-  file_info->filehandler->close();
+  if (file_info->transaction_done) {
+    // next statement continues reading the file
+    file_info->continuation = true;
+  } else {
+    file_info->filehandler->close();
+  }
 }
 
 int local_infile_error(void *userdata, char *error_msg,
@@ -201,28 +279,53 @@ void Load_data_worker::operator()() {
     return;
   }
 
-  execute(session, m_opt.create_file_handle());
+  // files to be loaded are specified by the blocks
+  execute(session, m_block_queue ? nullptr : m_opt.create_file_handle());
+}
+
+std::unique_ptr<mysqlshdk::storage::IFile> Load_data_worker::prepare_file(
+    std::unique_ptr<mysqlshdk::storage::IFile> file) const {
+  mysqlshdk::storage::IFile *raw_file = file.get();
+  mysqlshdk::storage::Compression compr = mysqlshdk::storage::Compression::NONE;
+
+  // file may already be decompressed by the caller
+  if (!dynamic_cast<mysqlshdk::storage::Compressed_file *>(raw_file)) {
+    try {
+      compr = mysqlshdk::storage::from_extension(
+          std::get<1>(shcore::path::split_extension(file->filename())));
+    } catch (...) {
+      compr = mysqlshdk::storage::Compression::NONE;
+    }
+  }
+
+  file = mysqlshdk::storage::make_file(std::move(file), compr);
+
+  // decompression and remote reads are done by a helper thread, so that
+  // server does not wait for them while data is being loaded, local and
+  // in-memory files are read directly
+  if (mysqlshdk::storage::Compression::NONE != compr ||
+      is_slow_to_read(raw_file)) {
+    file = std::make_unique<mysqlshdk::storage::Read_ahead_file>(
+        std::move(file), k_read_ahead_size, m_opt.memory_budget());
+  }
+
+  return file;
 }
 
 void Load_data_worker::execute(
     const std::shared_ptr<mysqlshdk::db::mysql::Session> &session,
     std::unique_ptr<mysqlshdk::storage::IFile> file) {
   mysqlshdk::storage::IFile *raw_file = file.get();
+  std::string task;
 
-  mysqlshdk::storage::Compression compr;
-  try {
-    compr = mysqlshdk::storage::from_extension(
-        std::get<1>(shcore::path::split_extension(file->filename())));
-  } catch (...) {
-    compr = mysqlshdk::storage::Compression::NONE;
+  if (file) {
+    file = prepare_file(std::move(file));
+    task = file->filename();
   }
 
-  file = mysqlshdk::storage::make_file(std::move(file), compr);
-  std::string task = file->filename();
-
   try {
     File_info fi;
-    fi.filename = file->full_path();
+    fi.filename = file ? file->full_path() : std::string{};
     fi.filehandler = std::move(file);
     fi.raw_filehandler = raw_file;
     fi.worker_id = m_thread_id;
@@ -233,6 +336,12 @@ void Load_data_worker::execute(
     fi.max_rate = m_opt.max_rate();
     fi.range_read = m_range_queue ? true : false;
 
+    if (!m_opt.dialect().lines_terminated_by.empty()) {
+      fi.max_transaction_size = m_opt.max_bytes_per_transaction();
+      fi.row_end = Row_end_finder(m_opt.dialect().lines_terminated_by,
+                                  m_opt.dialect().fields_escaped_by);
+    }
+
     // set session variables
     session->execute("SET unique_checks = 0");
     session->execute("SET foreign_key_checks = 0");
@@ -285,27 +394,37 @@ void Load_data_worker::execute(
       query_template.pop_back();  // strip the last ,
     }
 
-    shcore::sqlstring sql(query_template, 0);
-    sql << fi.filename << m_opt.schema() << m_opt.table();
-    for (const auto &col : columns) {
-      sql << col;
-    }
-    for (const auto &it : decode_columns) {
-      if (!it.second.empty()) sql << it.first << it.first;
-    }
-    sql.done();
+    const auto make_sql = [&](const std::string &filename) {
+      shcore::sqlstring sql(query_template, 0);
+      sql << filename << m_opt.schema() << m_opt.table();
+      for (const auto &col : columns) {
+        sql << col;
+      }
+      for (const auto &it : decode_columns) {
+        if (!it.second.empty()) sql << it.first << it.first;
+      }
+      sql.done();
+      return sql.str();
+    };
+
+    std::string sql = make_sql(fi.filename);
 
     char worker_name[64];
     snprintf(worker_name, sizeof(worker_name), "[Worker%03u] ",
              static_cast<unsigned int>(m_thread_id));
 
 #ifndef NDEBUG
-    log_debug("%s %s %i", worker_name, sql.str().c_str(),
-              m_range_queue != nullptr);
+    log_debug("%s %s %i", worker_name, sql.c_str(),
+              m_range_queue != nullptr || m_block_queue != nullptr);
 #endif
 
+    // index of the file opened by fi.filehandler
+    size_t file_index = std::string::npos;
+
     while (true) {
       mysqlsh::import_table::Range r;
+      // size of the decompressed data reserved in the budget
+      size_t reserved = 0;
 
       if (m_range_queue) {
         r = m_range_queue->pop();
@@ -316,124 +435,198 @@ void Load_data_worker::execute(
 
         fi.chunk_start = r.begin;
         fi.bytes_left = r.end - r.begin;
+      } else if (m_block_queue) {
+        auto block = m_block_queue->pop();
+
+        if (!block.whole_file && block.begin == block.end) {
+          break;
+        }
+
+        r = {block.begin, block.end};
+
+        if (fi.filename != m_opt.full_path(block.file)) {
+          fi.filename = m_opt.full_path(block.file);
+          task = shcore::path::basename(fi.filename);
+          sql = make_sql(fi.filename);
+        }
+
+        if (block.data.empty()) {
+          if (block.file != file_index) {
+            fi.filehandler =
+                prepare_file(m_opt.create_file_handle(block.file));
+            file_index = block.file;
+          }
+
+          fi.range_read = !block.whole_file;
+          fi.chunk_start = block.begin;
+          fi.bytes_left = block.end - block.begin;
+        } else {
+          // data was already read and decompressed
+          reserved = block.data.size();
+
+          auto memory =
+              std::make_unique<mysqlshdk::storage::backend::Memory_file>(
+                  fi.filename);
+          memory->set_content(std::move(block.data));
+
+          fi.filehandler = std::move(memory);
+          fi.range_read = false;
+          fi.chunk_start = 0;
+          fi.bytes_left = 0;
+          file_index = std::string::npos;
+        }
       } else {
         r = {0, 0};
         fi.chunk_start = 0;
         fi.bytes_left = 0;
       }
 
-      std::shared_ptr<mysqlshdk::db::IResult> load_result = nullptr;
-
-      try {
-        load_result = session->query(sql);
-
-        m_stats.total_bytes = fi.bytes;
-      } catch (const mysqlshdk::db::Error &e) {
-        m_thread_exception[m_thread_id] = std::current_exception();
-        const std::string error_msg{
-            worker_name + task + ": " + e.format() +
-            (fi.range_read ? " @ file bytes range [" + std::to_string(r.begin) +
-                                 ", " + std::to_string(r.end) + "): "
-                           : ": ") +
-            sql.str()};
-        mysqlsh::current_console()->print_error(error_msg);
-        throw std::runtime_error(error_msg);
-      } catch (const mysqlshdk::rest::Connection_error &e) {
-        m_thread_exception[m_thread_id] = std::current_exception();
-        const std::string error_msg{
-            worker_name + task + ": " + e.what() +
-            (fi.range_read ? " @ file bytes range [" + std::to_string(r.begin) +
-                                 ", " + std::to_string(r.end) + ")"
-                           : "")};
-        mysqlsh::current_console()->print_error(error_msg);
-        throw std::runtime_error(error_msg);
-      } catch (const std::exception &e) {
-        m_thread_exception[m_thread_id] = std::current_exception();
-        const std::string error_msg{
-            worker_name + task + ": " + e.what() +
-            (fi.range_read ? " @ file bytes range [" + std::to_string(r.begin) +
-                                 ", " + std::to_string(r.end) + ")"
-                           : "")};
-        mysqlsh::current_console()->print_error(error_msg);
-        throw std::exception(e);
-      }
-
-      const auto warnings_num =
-          load_result ? load_result->get_warning_count() : 0;
-
-      {
-        const char *mysql_info = session->get_mysql_info();
-        mysqlsh::current_console()->print_info(
-            worker_name + task + ": " + (mysql_info ? mysql_info : "ERROR"));
-
-        if (mysql_info) {
-          size_t records = 0;
-          size_t deleted = 0;
-          size_t skipped = 0;
-          size_t warnings = 0;
-
-          sscanf(mysql_info,
-                 "Records: %zu  Deleted: %zu  Skipped: %zu  Warnings: %zu\n",
-                 &records, &deleted, &skipped, &warnings);
-          m_stats.total_records += records;
-          m_stats.total_deleted += deleted;
-          m_stats.total_skipped += skipped;
-          m_stats.total_warnings += warnings;
+      // location of the data, reported in case of errors
+      const std::string range_info =
+          fi.range_read || reserved > 0
+              ? std::string{reserved > 0 ? " @ decompressed data" : " @ file"} +
+                    " bytes range [" + std::to_string(r.begin) + ", " +
+                    std::to_string(r.end) + ")"
+              : "";
+
+      // LOAD DATA is split into multiple statements if the transaction size
+      // is limited, each one continues reading where the previous one ended
+      size_t statements = 0;
+      bool info_missing = false;
+      Stats total;
+
+      do {
+        std::shared_ptr<mysqlshdk::db::IResult> load_result = nullptr;
+
+        try {
+          load_result = session->query(sql);
+          ++statements;
+
+          m_stats.total_bytes = fi.bytes;
+        } catch (const mysqlshdk::db::Error &e) {
+          m_thread_exception[m_thread_id] = std::current_exception();
+          const std::string error_msg{
+              worker_name + task + ": " + e.format() + range_info + ": " +
+              sql};
+          mysqlsh::current_console()->print_error(error_msg);
+          throw std::runtime_error(error_msg);
+        } catch (const mysqlshdk::rest::Connection_error &e) {
+          m_thread_exception[m_thread_id] = std::current_exception();
+          const std::string error_msg{
+              worker_name + task + ": " + e.what() + range_info};
+          mysqlsh::current_console()->print_error(error_msg);
+          throw std::runtime_error(error_msg);
+        } catch (const std::exception &e) {
+          m_thread_exception[m_thread_id] = std::current_exception();
+          const std::string error_msg{
+              worker_name + task + ": " + e.what() + range_info};
+          mysqlsh::current_console()->print_error(error_msg);
+          throw std::exception(e);
         }
 
-        if (warnings_num > 0) {
-          // show first k warnings, where k = warnings_to_show
-          constexpr int warnings_to_show = 5;
-          auto w = load_result->fetch_one_warning();
-
-          for (int i = 0; w && i < warnings_to_show;
-               w = load_result->fetch_one_warning(), i++) {
-            const std::string msg =
-                task + " error " + std::to_string(w->code) + ": " + w->msg;
-
-            switch (w->level) {
-              case mysqlshdk::db::Warning::Level::Error:
-                mysqlsh::current_console()->print_error(msg);
-                break;
-              case mysqlshdk::db::Warning::Level::Warn:
-                mysqlsh::current_console()->print_warning(msg);
-                break;
-              case mysqlshdk::db::Warning::Level::Note:
-                mysqlsh::current_console()->print_note(msg);
-                break;
-            }
+        const auto warnings_num =
+            load_result ? load_result->get_warning_count() : 0;
+
+        {
+          const char *mysql_info = session->get_mysql_info();
+
+          if (mysql_info) {
+            size_t records = 0;
+            size_t deleted = 0;
+            size_t skipped = 0;
+            size_t warnings = 0;
+
+            sscanf(mysql_info,
+                   "Records: %zu  Deleted: %zu  Skipped: %zu  Warnings: %zu\n",
+                   &records, &deleted, &skipped, &warnings);
+            m_stats.total_records += records;
+            m_stats.total_deleted += deleted;
+            m_stats.total_skipped += skipped;
+            m_stats.total_warnings += warnings;
+
+            total.total_records += records;
+            total.total_deleted += deleted;
+            total.total_skipped += skipped;
+            total.total_warnings += warnings;
+          } else {
+            info_missing = true;
           }
 
-          // log remaining warnings
-          size_t remaining_warnings_count = 0;
-          for (; w; w = load_result->fetch_one_warning()) {
-            remaining_warnings_count++;
-            const std::string msg =
-                task + " error " + std::to_string(w->code) + ": " + w->msg;
-
-            switch (w->level) {
-              case mysqlshdk::db::Warning::Level::Error:
-                log_error("%s", msg.c_str());
-                break;
-              case mysqlshdk::db::Warning::Level::Warn:
-                log_warning("%s", msg.c_str());
-                break;
-              case mysqlshdk::db::Warning::Level::Note:
-                log_info("%s", msg.c_str());
-                break;
+          if (!fi.continuation) {
+            // report the whole range, even if it was split into multiple
+            // statements
+            std::string info = "ERROR";
+
+            if (1 == statements) {
+              if (mysql_info) info = mysql_info;
+            } else if (!info_missing) {
+              info = total.to_string();
             }
+
+            mysqlsh::current_console()->print_info(worker_name + task + ": " +
+                                                   info);
           }
 
-          if (remaining_warnings_count > 0) {
-            mysqlsh::current_console()->print_info(
-                "Check mysqlsh.log for " +
-                std::to_string(remaining_warnings_count) + " more warning" +
-                (remaining_warnings_count == 1 ? "" : "s") + ".");
+          if (warnings_num > 0) {
+            // show first k warnings, where k = warnings_to_show
+            constexpr int warnings_to_show = 5;
+            auto w = load_result->fetch_one_warning();
+
+            for (int i = 0; w && i < warnings_to_show;
+                 w = load_result->fetch_one_warning(), i++) {
+              const std::string msg =
+                  task + " error " + std::to_string(w->code) + ": " + w->msg;
+
+              switch (w->level) {
+                case mysqlshdk::db::Warning::Level::Error:
+                  mysqlsh::current_console()->print_error(msg);
+                  break;
+                case mysqlshdk::db::Warning::Level::Warn:
+                  mysqlsh::current_console()->print_warning(msg);
+                  break;
+                case mysqlshdk::db::Warning::Level::Note:
+                  mysqlsh::current_console()->print_note(msg);
+                  break;
+              }
+            }
+
+            // log remaining warnings
+            size_t remaining_warnings_count = 0;
+            for (; w; w = load_result->fetch_one_warning()) {
+              remaining_warnings_count++;
+              const std::string msg =
+                  task + " error " + std::to_string(w->code) + ": " + w->msg;
+
+              switch (w->level) {
+                case mysqlshdk::db::Warning::Level::Error:
+                  log_error("%s", msg.c_str());
+                  break;
+                case mysqlshdk::db::Warning::Level::Warn:
+                  log_warning("%s", msg.c_str());
+                  break;
+                case mysqlshdk::db::Warning::Level::Note:
+                  log_info("%s", msg.c_str());
+                  break;
+              }
+            }
+
+            if (remaining_warnings_count > 0) {
+              mysqlsh::current_console()->print_info(
+                  "Check mysqlsh.log for " +
+                  std::to_string(remaining_warnings_count) + " more warning" +
+                  (remaining_warnings_count == 1 ? "" : "s") + ".");
+            }
           }
         }
-      }
+      } while (fi.continuation);
 
-      if (!m_range_queue) break;
+      if (m_block_queue) {
+        if (reserved > 0) {
+          m_block_budget->release(reserved);
+        }
+      } else if (!m_range_queue) {
+        break;
+      }
     }
   } catch (...) {
     m_thread_exception[m_thread_id] = std::current_exception();
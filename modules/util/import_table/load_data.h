@@ -36,6 +36,7 @@
 #include "mysqlshdk/libs/db/mysql/session.h"
 #include "mysqlshdk/libs/storage/ifile.h"
 #include "mysqlshdk/libs/textui/text_progress.h"
+#include "mysqlshdk/libs/utils/memory_budget.h"
 #include "mysqlshdk/libs/utils/rate_limit.h"
 #include "mysqlshdk/libs/utils/synchronized_queue.h"
 
@@ -63,6 +64,13 @@ struct File_info {
   std::atomic<size_t>
       *prog_bytes;  //< Pointer cumulative bytes send to MySQL Server
   volatile bool *user_interrupt = nullptr;  //< Pointer to user interrupt flag
+
+  size_t max_transaction_size = 0;  //< Max bytes sent by single LOAD DATA
+  Row_end_finder row_end;           //< Finds where LOAD DATA can be ended
+  size_t transaction_bytes = 0;     //< Bytes sent by current LOAD DATA
+  bool transaction_done = false;    //< Current LOAD DATA ended at row end
+  bool continuation = false;        //< Next LOAD DATA continues reading file
+  std::string pending;              //< Data read past the end of LOAD DATA
 };
 
 // Functions for local infile callbacks.
@@ -91,11 +99,24 @@ class Load_data_worker final {
 
   ~Load_data_worker() = default;
 
+  /**
+   * Worker loads the blocks of the imported files from the queue, memory used
+   * by the decompressed data is returned to the budget once it is loaded.
+   */
+  void set_block_queue(shcore::Synchronized_queue<Data_block> *queue,
+                       mysqlshdk::utils::Memory_budget *budget) {
+    m_block_queue = queue;
+    m_block_budget = budget;
+  }
+
   void operator()();
   void execute(const std::shared_ptr<mysqlshdk::db::mysql::Session> &session,
                std::unique_ptr<mysqlshdk::storage::IFile> file);
 
  private:
+  std::unique_ptr<mysqlshdk::storage::IFile> prepare_file(
+      std::unique_ptr<mysqlshdk::storage::IFile> file) const;
+
   const Import_table_options &m_opt;
   int64_t m_thread_id;
   mysqlshdk::textui::IProgress *m_progress;
@@ -103,6 +124,8 @@ class Load_data_worker final {
   std::mutex &m_output_mutex;
   volatile bool &m_interrupt;
   shcore::Synchronized_queue<Range> *m_range_queue;
+  shcore::Synchronized_queue<Data_block> *m_block_queue = nullptr;
+  mysqlshdk::utils::Memory_budget *m_block_budget = nullptr;
   std::vector<std::exception_ptr> &m_thread_exception;
   Stats &m_stats;
 };
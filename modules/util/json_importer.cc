@@ -27,9 +27,12 @@
 #else
 #include <sys/select.h>
 #endif
+#include <algorithm>
 #include <deque>
 #include <istream>
+#include <thread>
 #include <utility>
+#include <vector>
 #include "mysqlshdk/libs/db/mysqlx/session.h"
 #include "mysqlshdk/libs/db/mysqlx/util/setter_any.h"
 #include "mysqlshdk/libs/utils/utils_buffered_input.h"
@@ -180,6 +183,12 @@ Json_importer Prepare_json_import::build() {
  */
 static constexpr const int k_inserts_per_transaction = 8;
 
+/*
+ * Size of the data with whole JSON documents passed to a single worker during
+ * parallel import.
+ */
+static constexpr const size_t k_chunk_size = 16 * 1024 * 1024;
+
 Json_importer::Json_importer(
     const std::shared_ptr<mysqlshdk::db::mysqlx::Session> &session)
     : m_session(session) {
@@ -250,7 +259,11 @@ void Json_importer::load_from(const shcore::Document_reader_options &options) {
     input.open(full_path);
   }
 
-  load_from(&input, options);
+  if (m_threads > 1) {
+    load_in_parallel(&input, options);
+  } else {
+    load_from(&input, options);
+  }
 }
 
 void Json_importer::load_from(shcore::Buffered_input *input,
@@ -291,6 +304,223 @@ void Json_importer::load_from(shcore::Buffered_input *input,
   if (cancel) throw shcore::cancelled("JSON documents import cancelled.");
 }
 
+void Json_importer::load_in_parallel(
+    shcore::Buffered_input *input,
+    const shcore::Document_reader_options &options) {
+  m_stats.items_processed = 0;
+  m_stats.bytes_processed = 0;
+
+  const auto threads = static_cast<size_t>(m_threads);
+  Parallel_import state{2 * threads * k_chunk_size};
+
+  // each worker parses and inserts the documents using its own session
+  std::vector<Json_importer> workers;
+  workers.reserve(threads);
+
+  for (size_t i = 0; i < threads; ++i) {
+    auto session = mysqlshdk::db::mysqlx::Session::create();
+    session->connect(m_session->get_connection_options());
+
+    workers.emplace_back(session);
+
+    auto &worker = workers.back();
+    worker.m_batch_insert = m_batch_insert;
+    worker.m_total_imported = &state.imported;
+
+    if (m_print) {
+      worker.m_print = [this, &state](const std::string &msg) {
+        std::lock_guard<std::mutex> lock(state.print_mutex);
+        m_print(msg);
+      };
+    }
+  }
+
+  std::atomic<bool> cancel{false};
+  shcore::Interrupt_handler intr_handler([&cancel, &state]() -> bool {
+    cancel = true;
+    state.stop = true;
+    return false;
+  });
+
+  std::vector<std::exception_ptr> exceptions(threads);
+  std::vector<std::thread> pool;
+
+  for (size_t i = 0; i < threads; ++i) {
+    pool.emplace_back([&workers, &exceptions, &options, &state, i]() {
+      try {
+        workers[i].load_chunks(options, &state);
+      } catch (...) {
+        exceptions[i] = std::current_exception();
+        state.stop = true;
+      }
+    });
+  }
+
+  const auto push = [&state](Json_chunk &&chunk) {
+    // wait until the workers import enough of the queued data
+    while (!state.budget.acquire(chunk.data.size(),
+                                 std::chrono::milliseconds(100))) {
+      if (state.stop) {
+        return false;
+      }
+    }
+
+    state.queue.push(std::move(chunk));
+    return true;
+  };
+
+  try {
+    shcore::Json_reader reader(input, options);
+    reader.parse_bom();
+
+    Json_chunk chunk;
+    chunk.offset = input->offset();
+    chunk.data.reserve(k_chunk_size);
+
+    // documents are not parsed here, it's enough to track the nesting level
+    // and strings to find out where the top level documents end
+    size_t boundary = 0;  // end of the last complete document in the chunk
+    // incomplete document larger than this could not be inserted anyway,
+    // input is not buffered any further if it never ends
+    const size_t max_document_size =
+        std::max(k_chunk_size, m_packet_size_tracker.max_packet);
+    size_t depth = 0;
+    bool in_string = false;
+    bool escaped = false;
+
+    while (!state.stop) {
+      input->peek();
+
+      if (input->eof()) {
+        break;
+      }
+
+      const auto begin = input->pos();
+      const auto end = input->end();
+
+      for (auto p = begin; p != end; ++p) {
+        if (in_string) {
+          if (escaped) {
+            escaped = false;
+          } else if ('\\' == *p) {
+            escaped = true;
+          } else if ('"' == *p) {
+            in_string = false;
+          }
+        } else if ('"' == *p) {
+          in_string = true;
+        } else if ('{' == *p || '[' == *p) {
+          ++depth;
+        } else if (('}' == *p || ']' == *p) && depth > 0 && 0 == --depth) {
+          boundary = chunk.data.size() + (p - begin) + 1;
+        }
+      }
+
+      chunk.data.append(reinterpret_cast<const char *>(begin), end - begin);
+      input->seek(end);
+
+      if (chunk.data.size() - boundary > max_document_size) {
+        throw shcore::invalid_json(
+            "JSON document is not terminated within " +
+                std::to_string(max_document_size) + " bytes",
+            chunk.offset + boundary);
+      }
+
+      if (boundary >= k_chunk_size) {
+        Json_chunk next;
+        next.offset = chunk.offset + boundary;
+        next.data.reserve(k_chunk_size);
+        next.data.append(chunk.data, boundary, std::string::npos);
+
+        chunk.data.resize(boundary);
+
+        if (!push(std::move(chunk))) {
+          break;
+        }
+
+        chunk = std::move(next);
+        boundary = 0;
+      }
+    }
+
+    if (!chunk.data.empty() && !state.stop) {
+      push(std::move(chunk));
+    }
+  } catch (...) {
+    state.stop = true;
+    state.queue.shutdown(threads);
+
+    for (auto &t : pool) {
+      t.join();
+    }
+
+    throw;
+  }
+
+  state.queue.shutdown(threads);
+
+  for (auto &t : pool) {
+    t.join();
+  }
+
+  for (const auto &worker : workers) {
+    m_stats.items_processed += worker.m_stats.items_processed;
+    m_stats.bytes_processed += worker.m_stats.bytes_processed;
+    m_stats.documents_successfully_imported +=
+        worker.m_stats.documents_successfully_imported;
+  }
+
+  if (cancel) throw shcore::cancelled("JSON documents import cancelled.");
+
+  for (const auto &e : exceptions) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+void Json_importer::load_chunks(const shcore::Document_reader_options &options,
+                                Parallel_import *state) {
+  m_packet_size_tracker.inserts_in_this_transaction = 0;
+  m_packet_size_tracker.crud_insert_overhead_bytes =
+      m_batch_insert.ByteSizeLong();
+
+  m_session->execute("START TRANSACTION");
+
+  while (!state->stop) {
+    const auto chunk = state->queue.pop();
+
+    if (chunk.data.empty()) {
+      // queue was shut down, there are no more documents
+      break;
+    }
+
+    shcore::Buffered_input input;
+    input.open(chunk.data.data(), chunk.data.size());
+
+    shcore::Json_reader reader(&input, options);
+
+    try {
+      while (!reader.eof() && !state->stop) {
+        std::string jd = reader.next();
+
+        if (!jd.empty()) {
+          put(std::move(jd));
+        }
+      }
+    } catch (const shcore::invalid_json &e) {
+      // report the offset from the beginning of the input
+      throw shcore::invalid_json(e.std::invalid_argument::what(),
+                                 chunk.offset + e.offset());
+    }
+
+    state->budget.release(chunk.data.size());
+  }
+
+  flush();
+  commit(true);
+}
+
 void Json_importer::put(const std::string &item) {
   if (m_packet_size_tracker.will_overflow(item.size())) {
     flush();
@@ -312,8 +542,11 @@ void Json_importer::update_statistics(xcl::XQuery_result *xquery_result) {
   bool ret = xquery_result->try_get_affected_rows(&affected_rows);
   if (ret) {
     m_stats.documents_successfully_imported += affected_rows;
+    const uint64_t imported =
+        m_total_imported ? *m_total_imported += affected_rows
+                         : m_stats.documents_successfully_imported;
     if (m_print) {
-      m_print(".. " + std::to_string(m_stats.documents_successfully_imported));
+      m_print(".. " + std::to_string(imported));
     }
   }
 }
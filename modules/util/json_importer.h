@@ -24,14 +24,18 @@
 #ifndef MODULES_UTIL_JSON_IMPORTER_H_
 #define MODULES_UTIL_JSON_IMPORTER_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include "mysqlshdk/include/scripting/types.h"
 #include "mysqlshdk/libs/db/mysqlx/session.h"
 #include "mysqlshdk/libs/utils/document_parser.h"
+#include "mysqlshdk/libs/utils/memory_budget.h"
 #include "mysqlshdk/libs/utils/nullable.h"
 #include "mysqlshdk/libs/utils/profiling.h"
 #include "mysqlshdk/libs/utils/strformat.h"
+#include "mysqlshdk/libs/utils/synchronized_queue.h"
 #include "mysqlshdk/libs/utils/utils_path.h"
 #include "mysqlshdk/libs/utils/utils_sqlstring.h"
 #include "utils/utils_buffered_input.h"
@@ -201,13 +205,56 @@ class Json_importer {
    * @param path Path to JSON document. Empty path enables read from stdin.
    */
   void set_path(const std::string &path) { m_file_path = path; }
+
+  /**
+   * Set number of threads which parse and insert the documents, each of them
+   * uses its own X Protocol session.
+   * @param threads Number of threads.
+   */
+  void set_threads(int64_t threads) { m_threads = threads; }
+
   void load_from(const shcore::Document_reader_options &options);
 
   void print_stats();
 
  private:
+  /**
+   * Whole JSON documents read from the input.
+   */
+  struct Json_chunk {
+    size_t offset = 0;  //< Offset of the data from the input beginning
+    std::string data;   //< Data of the documents
+  };
+
+  /**
+   * State shared by the threads of parallel import.
+   */
+  struct Parallel_import {
+    explicit Parallel_import(size_t memory_limit) : budget(memory_limit) {}
+
+    shcore::Synchronized_queue<Json_chunk> queue;
+    mysqlshdk::utils::Memory_budget budget;  //< Memory used by queued chunks
+    std::atomic<bool> stop{false};           //< Import is cancelled or failed
+    std::atomic<uint64_t> imported{0};       //< Documents imported by workers
+    std::mutex print_mutex;
+  };
+
   void load_from(shcore::Buffered_input *input,
                  const shcore::Document_reader_options &options);
+
+  /**
+   * Splits the input into chunks of whole documents, which are parsed and
+   * inserted by the worker threads.
+   */
+  void load_in_parallel(shcore::Buffered_input *input,
+                        const shcore::Document_reader_options &options);
+
+  /**
+   * Imports the chunks read from the queue, executed by a worker thread.
+   */
+  void load_chunks(const shcore::Document_reader_options &options,
+                   Parallel_import *state);
+
   void put(const std::string &item);
   void recv_response(bool block = false);
   void flush();
@@ -287,6 +334,8 @@ class Json_importer {
 #endif
   int m_pending_response = 0;
   std::function<void(const std::string &)> m_print = nullptr;
+  int64_t m_threads = 1;
+  std::atomic<uint64_t> *m_total_imported = nullptr;  //< Set for workers
 
   struct {
     uint64_t items_processed = 0;
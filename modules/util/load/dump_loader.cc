@@ -53,6 +53,10 @@ static constexpr const int k_mysql_server_net_read_timeout = 30 * 60;
 static constexpr const int k_supported_dump_version_major = 1;
 static constexpr const int k_supported_dump_version_minor = 0;
 
+// uncompressed chunks which are at least twice this size are split into
+// sub-chunks of this size, loaded by several threads
+static constexpr const size_t k_sub_chunk_size = 128 * 1024 * 1024;
+
 class dump_wait_timeout : public std::runtime_error {
  public:
   explicit dump_wait_timeout(const char *w) : std::runtime_error(w) {}
@@ -78,6 +82,73 @@ bool has_pke(mysqlshdk::db::ISession *session, const std::string &schema,
   }
   return false;
 }
+
+uint64_t to_uint(const std::string &value) {
+  return value.empty() ? 0 : std::stoull(value);
+}
+
+// Returns the description of the first load threshold exceeded by the server,
+// or an empty string if it's within the limits. The own_threads sessions which
+// are busy executing statements of the load are not counted as the server load.
+std::string server_load_exceeded(mysqlshdk::db::ISession *session,
+                                 const Load_dump_options &options,
+                                 uint64_t own_threads) {
+  if (const auto limit = options.max_threads_running()) {
+    const auto row =
+        session->query("SHOW GLOBAL STATUS LIKE 'Threads_running'")
+            ->fetch_one_named();
+
+    if (row) {
+      // the session executing this query is running as well
+      ++own_threads;
+
+      auto value = to_uint(row.get_as_string("Value"));
+      value = value > own_threads ? value - own_threads : 0;
+
+      if (value > limit) {
+        return "Threads_running of other sessions is " +
+               std::to_string(value) + " (maxThreadsRunning: " +
+               std::to_string(limit) + ")";
+      }
+    }
+  }
+
+  if (const auto limit = options.max_history_list_length()) {
+    const auto row =
+        session
+            ->query(
+                "SELECT COUNT FROM information_schema.innodb_metrics WHERE "
+                "NAME = 'trx_rseg_history_len' AND STATUS = 'enabled'")
+            ->fetch_one();
+
+    if (row) {
+      const auto value = to_uint(row->get_as_string(0));
+
+      if (value > limit) {
+        return "InnoDB history list length is " + std::to_string(value) +
+               " (maxHistoryListLength: " + std::to_string(limit) + ")";
+      }
+    }
+  }
+
+  if (const auto limit = options.max_replication_lag()) {
+    // only set if the target server is a replica, checks all the channels
+    const auto result = session->query("SHOW SLAVE STATUS");
+
+    while (const auto row = result->fetch_one_named()) {
+      if (row.is_null("Seconds_Behind_Master")) continue;
+
+      const auto value = to_uint(row.get_as_string("Seconds_Behind_Master"));
+
+      if (value > limit) {
+        return "Replication lag is " + std::to_string(value) +
+               " seconds (maxReplicationLag: " + std::to_string(limit) + ")";
+      }
+    }
+  }
+
+  return "";
+}
 }  // namespace
 
 namespace loader {
@@ -148,6 +219,8 @@ bool Dump_loader::Worker::Load_chunk_task::execute(
     if (!loader->m_options.dry_run()) {
       // load the data
       load(session, loader);
+    } else {
+      remove_from_tables_being_loaded(loader);
     }
   } catch (const std::exception &e) {
     if (!loader->m_thread_exceptions[id()]) {
@@ -166,6 +239,20 @@ bool Dump_loader::Worker::Load_chunk_task::execute(
   return true;
 }
 
+void Dump_loader::Worker::Load_chunk_task::remove_from_tables_being_loaded(
+    Dump_loader *loader) const {
+  std::lock_guard<std::mutex> lock(loader->m_tables_being_loaded_mutex);
+  auto key = schema_table_key(schema(), table());
+  auto it = loader->m_tables_being_loaded.find(key);
+  while (it != loader->m_tables_being_loaded.end() && it->first == key) {
+    if (it->second == raw_bytes_loaded) {
+      loader->m_tables_being_loaded.erase(it);
+      break;
+    }
+    ++it;
+  }
+}
+
 void Dump_loader::Worker::Load_chunk_task::load(
     const std::shared_ptr<mysqlshdk::db::mysql::Session> &session,
     Dump_loader *loader) {
@@ -176,6 +263,8 @@ void Dump_loader::Worker::Load_chunk_task::load(
 
   import_options.base_session(session);
 
+  import_options.set_memory_budget(loader->m_memory_budget.get());
+
   // options.set_options(m_options);
   import_options.validate();
 
@@ -192,26 +281,25 @@ void Dump_loader::Worker::Load_chunk_task::load(
     }
   }
 
+  // sub-chunk is loaded by reading just its range of the chunk file
+  shcore::Synchronized_queue<import_table::Range> range_queue;
+
+  if (is_sub_chunk()) {
+    range_queue.push(m_range);
+    range_queue.shutdown(1);
+  }
+
   import_table::Load_data_worker op(
       import_options, id(), loader->m_progress.get(), &loader->m_output_mutex,
-      &loader->m_num_bytes_loaded, &loader->m_worker_hard_interrupt, nullptr,
-      &loader->m_thread_exceptions, &stats);
+      &loader->m_num_bytes_loaded, &loader->m_worker_hard_interrupt,
+      is_sub_chunk() ? &range_queue : nullptr, &loader->m_thread_exceptions,
+      &stats);
 
   loader->m_num_threads_loading++;
   loader->update_progress();
 
   shcore::on_leave_scope cleanup([this, loader]() {
-    std::lock_guard<std::mutex> lock(loader->m_tables_being_loaded_mutex);
-    auto key = schema_table_key(schema(), table());
-    auto it = loader->m_tables_being_loaded.find(key);
-    while (it != loader->m_tables_being_loaded.end() && it->first == key) {
-      if (it->second == raw_bytes_loaded) {
-        loader->m_tables_being_loaded.erase(it);
-        break;
-      }
-      ++it;
-    }
-
+    remove_from_tables_being_loaded(loader);
     loader->m_num_threads_loading--;
   });
 
@@ -228,7 +316,8 @@ void Dump_loader::Worker::Load_chunk_task::load(
   bytes_loaded = stats.total_bytes;
   loader->m_num_raw_bytes_loaded += raw_bytes_loaded;
 
-  loader->m_num_chunks_loaded += 1;
+  // a split chunk is counted once all of its sub-chunks are loaded
+  if (!is_sub_chunk()) loader->m_num_chunks_loaded += 1;
   loader->m_num_rows_loaded += stats.total_records;
   loader->m_num_warnings += stats.total_warnings;
 }
@@ -288,6 +377,34 @@ bool Dump_loader::Worker::Analyze_table_task::execute(
   return true;
 }
 
+bool Dump_loader::Worker::Table_ddl_task::execute(
+    const std::shared_ptr<mysqlshdk::db::mysql::Session> &session,
+    Worker *worker, Dump_loader *loader) {
+  log_debug("worker%zu will execute DDL for table `%s`.`%s`", id(),
+            schema().c_str(), table().c_str());
+
+  loader->post_worker_event(worker, Worker_event::TABLE_DDL_START);
+
+  // do work
+
+  try {
+    loader->handle_table(session, schema(), table(), m_script, m_resuming,
+                         m_indexes_deferred);
+  } catch (...) {
+    // error was already reported by handle_table()
+    loader->m_thread_exceptions[id()] = std::current_exception();
+
+    loader->post_worker_event(worker, Worker_event::FATAL_ERROR);
+    return false;
+  }
+
+  log_debug("worker%zu done", id());
+
+  // signal for more work
+  loader->post_worker_event(worker, Worker_event::TABLE_DDL_END);
+  return true;
+}
+
 bool Dump_loader::Worker::Index_recreation_task::execute(
     const std::shared_ptr<mysqlshdk::db::mysql::Session> &session,
     Worker *worker, Dump_loader *loader) {
@@ -310,11 +427,24 @@ bool Dump_loader::Worker::Index_recreation_task::execute(
         [loader]() { loader->m_num_threads_recreating_indexes--; });
 
     try {
+      using std::chrono::duration_cast;
+      using std::chrono::milliseconds;
+      using std::chrono::steady_clock;
+
+      const auto table_start = steady_clock::now();
       int retries = 0;
       session->execute("SET unique_checks = 0");
       for (size_t i = 0; i < m_queries.size(); i++) {
         try {
+          const auto start = steady_clock::now();
           session->execute(m_queries[i]);
+          const auto ms =
+              duration_cast<milliseconds>(steady_clock::now() - start).count();
+
+          log_info("[Worker%03zu] %s took %s", id(), m_queries[i].c_str(),
+                   mysqlshdk::utils::format_seconds(ms / 1000.0).c_str());
+          loader->m_num_indexes_recreated++;
+          loader->m_index_recreation_ms += ms;
         } catch (const shcore::Error &e) {
           // Deadlocks and duplicate key errors should not happen but if they do
           // they can be ignored at least for a while
@@ -333,6 +463,16 @@ bool Dump_loader::Worker::Index_recreation_task::execute(
           }
         }
       }
+
+      if (!m_queries.empty())
+        console->print_status(shcore::str_format(
+            "Recreated %zu indexes for `%s`.`%s` in %s", m_queries.size(),
+            schema().c_str(), table().c_str(),
+            mysqlshdk::utils::format_seconds(
+                duration_cast<milliseconds>(steady_clock::now() - table_start)
+                        .count() /
+                    1000.0)
+                .c_str()));
     } catch (const std::exception &e) {
       console->print_error(shcore::str_format(
           "[Worker%03zu] While recreating indexes for table `%s`.`%s`: %s",
@@ -393,19 +533,35 @@ void Dump_loader::Worker::connect() {
 void Dump_loader::Worker::load_chunk_file(
     const std::string &schema, const std::string &table,
     std::unique_ptr<mysqlshdk::storage::IFile> file, ssize_t chunk_index,
-    size_t chunk_size, const shcore::Dictionary_t &options, bool resuming) {
+    size_t chunk_size, const shcore::Dictionary_t &options, bool resuming,
+    const import_table::Range &range) {
   log_debug("Loading data for `%s`.`%s` (chunk %zi)", schema.c_str(),
             table.c_str(), chunk_index);
   assert(!schema.empty());
   assert(!table.empty());
 
-  m_task = std::make_unique<Load_chunk_task>(
-      m_id, schema, table, chunk_index, std::move(file), options, resuming);
+  m_task = std::make_unique<Load_chunk_task>(m_id, schema, table, chunk_index,
+                                             std::move(file), options,
+                                             resuming, range);
   static_cast<Load_chunk_task *>(m_task.get())->raw_bytes_loaded = chunk_size;
 
   m_work_ready.push(true);
 }
 
+void Dump_loader::Worker::execute_table_ddl(const std::string &schema,
+                                            const std::string &table,
+                                            const std::string &script,
+                                            bool resuming,
+                                            bool indexes_deferred) {
+  log_debug("Executing DDL for `%s`.`%s`", schema.c_str(), table.c_str());
+  assert(!schema.empty());
+  assert(!table.empty());
+
+  m_task = std::make_unique<Table_ddl_task>(m_id, schema, table, script,
+                                            resuming, indexes_deferred);
+  m_work_ready.push(true);
+}
+
 void Dump_loader::Worker::recreate_indexes(
     const std::string &schema, const std::string &table,
     const std::vector<std::string> &indexes) {
@@ -443,7 +599,9 @@ Dump_loader::Dump_loader(const Load_dump_options &options)
       m_num_raw_bytes_loaded(0),
       m_num_chunks_loaded(0),
       m_num_warnings(0),
-      m_num_errors(0) {
+      m_num_errors(0),
+      m_num_indexes_recreated(0),
+      m_index_recreation_ms(0) {
   bool use_json = (mysqlsh::current_shell_options()->get().wrap_json != "off");
 
   if (m_options.show_progress()) {
@@ -461,6 +619,11 @@ Dump_loader::Dump_loader(const Load_dump_options &options)
   if (m_options.ignore_version()) {
     m_default_sql_transforms.add_strip_removed_sql_modes();
   }
+
+  if (m_options.max_memory() > 0) {
+    m_memory_budget = std::make_unique<mysqlshdk::utils::Memory_budget>(
+        m_options.max_memory());
+  }
 }
 
 Dump_loader::~Dump_loader() {}
@@ -626,8 +789,15 @@ void Dump_loader::handle_schema_scripts() {
       m_load_log->start_schema_ddl(schema);
       handle_schema(schema, tables, views);
       m_load_log->end_schema_ddl(schema);
+    } else {
+      // there's no DDL to execute, data can be loaded right away
+      for (const auto &it : tables) {
+        m_dump->on_table_ddl_end(schema, it.first);
+      }
     }
   }
+
+  handle_views();
 }
 
 void Dump_loader::handle_schema(
@@ -673,11 +843,16 @@ void Dump_loader::handle_schema(
           e.what()));
       if (!m_options.force()) throw;
       m_skip_schemas.insert(schema);
+
+      for (const auto &it : tables) {
+        m_dump->on_table_ddl_end(schema, it.first);
+      }
+
       return;
     }
   }
 
-  // Process tables of the schema
+  // Process tables of the schema, DDL is executed by the workers
   for (const auto &it : tables) {
     const std::string &table = it.first;
 
@@ -701,16 +876,22 @@ void Dump_loader::handle_schema(
                            status == Load_progress_log::DONE);
 
       if (status != Load_progress_log::DONE && m_options.load_ddl()) {
-        m_load_log->start_table_ddl(schema, table);
-        handle_table(schema, table, script,
-                     status == Load_progress_log::INTERRUPTED,
-                     indexes_deferred);
-        m_load_log->end_table_ddl(schema, table);
+        Table_ddl ddl;
+        ddl.schema = schema;
+        ddl.table = table;
+        ddl.script = std::move(script);
+        ddl.resuming = status == Load_progress_log::INTERRUPTED;
+        ddl.indexes_deferred = indexes_deferred;
+
+        m_pending_table_ddl.emplace_back(std::move(ddl));
+        continue;
       }
     }
+
+    m_dump->on_table_ddl_end(schema, table);
   }
 
-  // Process views after all tables have been created
+  // Views are processed after all tables have been created
   for (const auto &it : views) {
     const std::string &view = it.first;
 
@@ -720,18 +901,58 @@ void Dump_loader::handle_schema(
               to_string(status).c_str());
 
     if (m_options.load_ddl()) {
-      m_load_log->start_table_ddl(schema, view);
+      View_ddl ddl;
+      ddl.schema = schema;
+      ddl.view = view;
+      ddl.done = status == Load_progress_log::DONE;
+      ddl.resuming = status == Load_progress_log::INTERRUPTED;
 
-      if (status != Load_progress_log::DONE) {
+      if (!ddl.done) {
         it.second->open(mysqlshdk::storage::Mode::READ);
-        auto script = mysqlshdk::storage::read_file(it.second.get());
-
-        handle_table(schema, view, script,
-                     status == Load_progress_log::INTERRUPTED);
+        ddl.script = mysqlshdk::storage::read_file(it.second.get());
       }
 
-      m_load_log->end_table_ddl(schema, view);
+      m_pending_view_ddl.emplace_back(std::move(ddl));
+    }
+  }
+}
+
+bool Dump_loader::schedule_table_ddl(Worker *worker) {
+  if (m_pending_table_ddl.empty()) {
+    return false;
+  }
+
+  const auto ddl = std::move(m_pending_table_ddl.front());
+  m_pending_table_ddl.pop_front();
+
+  m_load_log->start_table_ddl(ddl.schema, ddl.table);
+
+  ++m_num_table_ddl_tasks;
+  worker->execute_table_ddl(ddl.schema, ddl.table, ddl.script, ddl.resuming,
+                            ddl.indexes_deferred);
+
+  return true;
+}
+
+void Dump_loader::handle_views() {
+  // views can reference tables from any schema, they are created once all the
+  // tables known so far exist
+  if (m_num_table_ddl_tasks > 0 || !m_pending_table_ddl.empty()) {
+    return;
+  }
+
+  while (!m_pending_view_ddl.empty()) {
+    const auto &ddl = m_pending_view_ddl.front();
+
+    m_load_log->start_table_ddl(ddl.schema, ddl.view);
+
+    if (!ddl.done) {
+      handle_table(m_session, ddl.schema, ddl.view, ddl.script, ddl.resuming);
     }
+
+    m_load_log->end_table_ddl(ddl.schema, ddl.view);
+
+    m_pending_view_ddl.pop_front();
   }
 }
 
@@ -805,10 +1026,10 @@ bool Dump_loader::handle_indexes(const std::string &schema,
   return true;
 }
 
-void Dump_loader::handle_table(const std::string &schema,
-                               const std::string &table,
-                               const std::string &script, bool resuming,
-                               bool indexes_deferred) {
+void Dump_loader::handle_table(
+    const std::shared_ptr<mysqlshdk::db::ISession> &session,
+    const std::string &schema, const std::string &table,
+    const std::string &script, bool resuming, bool indexes_deferred) {
   std::string key = schema_table_key(schema, table);
 
   log_debug("Executing table DDL for %s", key.c_str());
@@ -820,8 +1041,12 @@ void Dump_loader::handle_table(const std::string &schema,
         key +
         (indexes_deferred ? " (indexes removed for deferred creation)" : ""));
     if (!m_options.dry_run()) {
+      // tables are created in no particular order by different sessions
+      session->execute("SET foreign_key_checks = 0");
+      session->executef("USE !", schema);
+
       // execute sql
-      execute_script(m_session, script,
+      execute_script(session, script,
                      shcore::str_format("Error processing table `%s`.`%s`",
                                         schema.c_str(), table.c_str()));
     }
@@ -835,6 +1060,11 @@ void Dump_loader::handle_table(const std::string &schema,
 }
 
 bool Dump_loader::handle_table_data(Worker *worker) {
+  // the server is under pressure, don't load more data at the same time
+  if (m_num_load_tasks >= m_max_load_tasks) {
+    return false;
+  }
+
   std::unique_ptr<mysqlshdk::storage::IFile> data_file;
 
   bool scheduled = false;
@@ -849,6 +1079,11 @@ bool Dump_loader::handle_table_data(Worker *worker) {
 
   // Note: job scheduling should preferrably load different tables per thread
 
+  // ranges of chunks which were already split are loaded first
+  if (schedule_sub_chunk(worker)) {
+    return true;
+  }
+
   do {
     {
       std::lock_guard<std::mutex> lock(m_tables_being_loaded_mutex);
@@ -865,6 +1100,15 @@ bool Dump_loader::handle_table_data(Worker *worker) {
         options->set("characterSet", shcore::Value(m_options.character_set()));
       }
 
+      if (!m_options.max_rate().empty()) {
+        options->set("maxRate", shcore::Value(m_options.max_rate()));
+      }
+
+      if (!m_options.max_bytes_per_transaction().empty()) {
+        options->set("maxBytesPerTransaction",
+                     shcore::Value(m_options.max_bytes_per_transaction()));
+      }
+
       auto status =
           m_load_log->table_chunk_status(schema, table, chunked ? index : -1);
 
@@ -896,6 +1140,12 @@ bool Dump_loader::schedule_table_chunk(
       !m_options.include_table(schema, table))
     return false;
 
+  // large chunks are split and loaded by several workers
+  if (split_table_chunk(schema, table, chunk_index, file->filename(), size,
+                        options, resuming)) {
+    return schedule_sub_chunk(worker);
+  }
+
   {
     std::lock_guard<std::mutex> lock(m_tables_being_loaded_mutex);
     m_tables_being_loaded.emplace(schema_table_key(schema, table),
@@ -905,8 +1155,135 @@ bool Dump_loader::schedule_table_chunk(
   log_debug("Scheduling chunk for table %s.%s (%s) - worker%zi", schema.c_str(),
             table.c_str(), file->full_path().c_str(), worker->id());
 
+  if (m_options.dry_run()) {
+    current_console()->print_info(shcore::str_format(
+        "Worker%03zu: %s of `%s`.`%s` (%s)", worker->id(),
+        file->filename().c_str(), schema.c_str(), table.c_str(),
+        mysqlshdk::utils::format_bytes(size).c_str()));
+  }
+
+  ++m_num_load_tasks;
   worker->load_chunk_file(schema, table, std::move(file), chunk_index, size,
-                          options, resuming);
+                          options, resuming, {0, 0});
+
+  return true;
+}
+
+bool Dump_loader::split_table_chunk(const std::string &schema,
+                                    const std::string &table,
+                                    ssize_t chunk_index,
+                                    const std::string &file, size_t size,
+                                    const shcore::Dictionary_t &options,
+                                    bool resuming) {
+  // data of a non-chunked table without a PK cannot be replaced, such table
+  // is truncated and the whole chunk is loaded again
+  if (resuming && chunk_index < 0 && !has_pke(session(), schema, table)) {
+    return false;
+  }
+
+  const auto ranges = m_dump->split_data_file(file, size, k_sub_chunk_size);
+
+  if (ranges.empty()) {
+    return false;
+  }
+
+  log_debug("Splitting chunk %s of table %s.%s into %zu sub-chunks",
+            file.c_str(), schema.c_str(), table.c_str(), ranges.size());
+
+  const auto key = schema_table_key(schema, table);
+  auto &chunk = m_split_chunks[key + ":" + std::to_string(chunk_index)];
+
+  // chunk was already started if load is resumed
+  chunk.file = file;
+  chunk.started = resuming;
+  chunk.pending = 0;
+
+  for (const auto &range : ranges) {
+    // sub-chunks which were loaded before the load was interrupted are skipped
+    if (resuming && Load_progress_log::DONE ==
+                        m_load_log->table_sub_chunk_status(
+                            schema, table, chunk_index, range.begin)) {
+      continue;
+    }
+
+    // sub-chunks are marked as being loaded once they're scheduled, until
+    // then table is not considered to be fully loaded because of the pending
+    // ones
+    m_pending_sub_chunks.emplace_back(
+        Sub_chunk{schema, table, chunk_index, file, options, range});
+    ++chunk.pending;
+  }
+
+  if (0 == chunk.pending) {
+    // all sub-chunks were loaded, but chunk was not marked as done
+    m_split_chunks.erase(key + ":" + std::to_string(chunk_index));
+    on_chunk_load_end(schema, table, chunk_index, 0, 0);
+    remove_data_file(file);
+  }
+
+  return true;
+}
+
+bool Dump_loader::schedule_sub_chunk(Worker *worker) {
+  if (m_pending_sub_chunks.empty()) {
+    return false;
+  }
+
+  auto it = m_pending_sub_chunks.begin();
+
+  if (const auto max_threads = m_options.max_threads_per_table()) {
+    std::unordered_map<std::string, size_t> threads;
+
+    {
+      std::lock_guard<std::mutex> lock(m_tables_being_loaded_mutex);
+
+      for (const auto &table : m_tables_being_loaded) {
+        ++threads[table.first];
+      }
+    }
+
+    it = std::find_if(m_pending_sub_chunks.begin(), m_pending_sub_chunks.end(),
+                      [&threads, max_threads](const Sub_chunk &sc) {
+                        return threads[schema_table_key(sc.schema, sc.table)] <
+                               max_threads;
+                      });
+
+    if (m_pending_sub_chunks.end() == it) {
+      return false;
+    }
+  }
+
+  auto sub_chunk = std::move(*it);
+  m_pending_sub_chunks.erase(it);
+
+  {
+    std::lock_guard<std::mutex> lock(m_tables_being_loaded_mutex);
+    m_tables_being_loaded.emplace(
+        schema_table_key(sub_chunk.schema, sub_chunk.table),
+        sub_chunk.range.end - sub_chunk.range.begin);
+  }
+
+  log_debug("Scheduling sub-chunk [%zu, %zu) for table %s.%s (%s) - worker%zi",
+            sub_chunk.range.begin, sub_chunk.range.end,
+            sub_chunk.schema.c_str(), sub_chunk.table.c_str(),
+            sub_chunk.file.c_str(), worker->id());
+
+  if (m_options.dry_run()) {
+    current_console()->print_info(shcore::str_format(
+        "Worker%03zu: %s, bytes [%zu, %zu) of `%s`.`%s` (%s)", worker->id(),
+        sub_chunk.file.c_str(), sub_chunk.range.begin, sub_chunk.range.end,
+        sub_chunk.schema.c_str(), sub_chunk.table.c_str(),
+        mysqlshdk::utils::format_bytes(sub_chunk.range.end -
+                                       sub_chunk.range.begin)
+            .c_str()));
+  }
+
+  ++m_num_load_tasks;
+  worker->load_chunk_file(sub_chunk.schema, sub_chunk.table,
+                          m_dump->data_file(sub_chunk.file),
+                          sub_chunk.chunk_index,
+                          sub_chunk.range.end - sub_chunk.range.begin,
+                          sub_chunk.options, false, sub_chunk.range);
 
   return true;
 }
@@ -924,6 +1301,10 @@ size_t Dump_loader::handle_worker_events() {
         return "LOAD_START";
       case Worker_event::Event::LOAD_END:
         return "LOAD_END";
+      case Worker_event::Event::TABLE_DDL_START:
+        return "TABLE_DDL_START";
+      case Worker_event::Event::TABLE_DDL_END:
+        return "TABLE_DDL_END";
       case Worker_event::Event::INDEX_START:
         return "INDEX_START";
       case Worker_event::Event::INDEX_END:
@@ -949,6 +1330,15 @@ size_t Dump_loader::handle_worker_events() {
     for (;;) {
       update_progress();
 
+      if (check_server_load() && !idle_workers.empty()) {
+        // more workers are allowed to load data, wake up the idle ones
+        for (auto *worker : idle_workers) {
+          m_worker_events.push({Worker_event::READY, worker});
+        }
+
+        idle_workers.clear();
+      }
+
       event = m_worker_events.try_pop(1000);
       if (event.worker) break;
     }
@@ -961,7 +1351,13 @@ size_t Dump_loader::handle_worker_events() {
         auto task = static_cast<Worker::Load_chunk_task *>(
             event.worker->current_task());
 
-        on_chunk_load_start(task->schema(), task->table(), task->chunk_index());
+        if (task->is_sub_chunk()) {
+          on_sub_chunk_load_start(task->schema(), task->table(),
+                                  task->chunk_index(), task->range());
+        } else {
+          on_chunk_load_start(task->schema(), task->table(),
+                              task->chunk_index());
+        }
         break;
       }
 
@@ -969,18 +1365,55 @@ size_t Dump_loader::handle_worker_events() {
         auto task = static_cast<Worker::Load_chunk_task *>(
             event.worker->current_task());
 
-        on_chunk_load_end(task->schema(), task->table(), task->chunk_index(),
-                          task->bytes_loaded, task->raw_bytes_loaded);
+        if (task->is_sub_chunk()) {
+          on_sub_chunk_load_end(task->schema(), task->table(),
+                                task->chunk_index(), task->range(),
+                                task->bytes_loaded, task->raw_bytes_loaded);
+        } else {
+          on_chunk_load_end(task->schema(), task->table(), task->chunk_index(),
+                            task->bytes_loaded, task->raw_bytes_loaded);
+          remove_data_file(task->filename());
+        }
 
+        assert(m_num_load_tasks > 0);
+        --m_num_load_tasks;
         event.event = Worker_event::READY;
         break;
       }
 
+      case Worker_event::TABLE_DDL_END: {
+        const auto task = event.worker->current_task();
+
+        m_load_log->end_table_ddl(task->schema(), task->table());
+        m_dump->on_table_ddl_end(task->schema(), task->table());
+
+        assert(m_num_table_ddl_tasks > 0);
+        --m_num_table_ddl_tasks;
+
+        handle_views();
+
+        // data of the table can be loaded now, wake up the idle workers
+        for (auto *worker : idle_workers) {
+          m_worker_events.push({Worker_event::READY, worker});
+        }
+
+        idle_workers.clear();
+
+        event.event = Worker_event::READY;
+        break;
+      }
+
+      case Worker_event::TABLE_DDL_START:
       case Worker_event::INDEX_START:
       case Worker_event::ANALYZE_START:
         break;
 
       case Worker_event::INDEX_END:
+        assert(m_num_index_tasks > 0);
+        --m_num_index_tasks;
+        event.event = Worker_event::READY;
+        break;
+
       case Worker_event::ANALYZE_END:
         event.event = Worker_event::READY;
         break;
@@ -1022,13 +1455,30 @@ size_t Dump_loader::handle_worker_events() {
 }
 
 bool Dump_loader::schedule_next_task(Worker *worker) {
+  // tables need to be created before anything else can be done with them
+  if (schedule_table_ddl(worker)) {
+    return true;
+  }
+
   if (!handle_table_data(worker)) {
     std::string schema;
     std::string table;
     if (m_options.load_indexes() &&
         m_options.defer_table_indexes() !=
-            Load_dump_options::Defer_index_mode::OFF) {
+            Load_dump_options::Defer_index_mode::OFF &&
+        // index builds load the server as well, they're throttled with data
+        m_num_index_tasks <
+            std::min(static_cast<size_t>(m_options.index_threads_count()),
+                     m_max_load_tasks)) {
       const auto load_finished = [this](const std::string &key) {
+        if (std::any_of(m_pending_sub_chunks.begin(),
+                        m_pending_sub_chunks.end(),
+                        [&key](const Sub_chunk &sc) {
+                          return key == schema_table_key(sc.schema, sc.table);
+                        })) {
+          return false;
+        }
+
         std::lock_guard<std::mutex> lock(m_tables_being_loaded_mutex);
         return m_tables_being_loaded.find(key) == m_tables_being_loaded.end();
       };
@@ -1036,6 +1486,7 @@ bool Dump_loader::schedule_next_task(Worker *worker) {
       if (m_dump->next_deferred_index(&schema, &table, &indexes,
                                       load_finished)) {
         assert(indexes != nullptr);
+        ++m_num_index_tasks;
         worker->recreate_indexes(schema, table, *indexes);
         return true;
       }
@@ -1085,6 +1536,8 @@ void Dump_loader::interrupt() {
   }
 }
 
+void Dump_loader::stop() { m_worker_interrupt = true; }
+
 void Dump_loader::run() {
   m_begin_time = std::chrono::system_clock::now();
 
@@ -1144,6 +1597,12 @@ void Dump_loader::show_summary() {
             m_num_bytes_loaded.load() - m_num_bytes_previously_loaded, seconds)
             .c_str()));
   }
+  if (m_num_indexes_recreated > 0) {
+    console->print_info(shcore::str_format(
+        "%zi indexes were recreated in %s of cumulative build time.",
+        m_num_indexes_recreated.load(),
+        format_seconds(m_index_recreation_ms.load() / 1000.0, false).c_str()));
+  }
   if (m_num_errors > 0) {
     console->print_info(shcore::str_format(
         "%zi errors and %zi warnings messages were reported during the load.",
@@ -1197,8 +1656,12 @@ void Dump_loader::update_progress() {
 
 void Dump_loader::open_dump() {
   auto console = current_console();
-  m_dump =
-      std::make_unique<Dump_reader>(m_options.create_dump_handle(), m_options);
+  auto directory = m_options.create_dump_handle();
+  // in-memory dump is written by this process, loader is notified about the
+  // new files instead of polling for them
+  m_memory_dump = dynamic_cast<mysqlshdk::storage::backend::Memory_directory *>(
+      directory.get());
+  m_dump = std::make_unique<Dump_reader>(std::move(directory), m_options);
 
   auto status = m_dump->open();
 
@@ -1469,10 +1932,20 @@ void Dump_loader::setup_progress(bool *out_is_resuming) {
       !m_options.progress_file()->empty()) {
     auto progress_file = m_options.create_progress_file_handle();
     std::string path = progress_file->full_path();
-    bool rewrite_on_flush = m_options.oci_options() ? true : false;
+    Load_progress_log::Segment_factory segment;
+
+    // objects in the bucket cannot be appended to, new entries are written to
+    // separate objects
+    if (m_options.oci_options() && m_options.progress_file().is_null()) {
+      std::shared_ptr<mysqlshdk::storage::IDirectory> dir =
+          m_options.create_dump_handle();
+      segment = [dir, name = progress_file->filename()](size_t n) {
+        return dir->file(name + "." + std::to_string(n));
+      };
+    }
 
     auto progress = m_load_log->init(std::move(progress_file),
-                                     m_options.dry_run(), rewrite_on_flush);
+                                     m_options.dry_run(), segment);
     if (progress.status != Load_progress_log::PENDING) {
       if (!m_options.reset_progress()) {
         console->print_note(
@@ -1538,6 +2011,8 @@ void Dump_loader::execute_tasks() {
 
   m_session = create_session(false);
 
+  m_max_load_tasks = m_options.threads_count();
+
   setup_progress(&m_resuming);
 
   if (!m_resuming && m_options.load_ddl()) check_existing_objects();
@@ -1560,12 +2035,15 @@ void Dump_loader::execute_tasks() {
       // process dump metadata first
       on_dump_begin();
 
-      handle_schema_scripts();
       m_init_done = true;
 
       m_progress->hide(false);
     }
 
+    // create schemas which became available, DDL of their tables is executed
+    // by the workers and their data is loaded once it's done
+    handle_schema_scripts();
+
     // handle events from workers and schedule more chunks when a worker
     // becomes available
     num_idle_workers = handle_worker_events();
@@ -1594,6 +2072,57 @@ void Dump_loader::execute_tasks() {
   log_debug("Import done");
 }
 
+bool Dump_loader::check_server_load() {
+  if (!m_options.throttle_on_server_load() || m_options.dry_run()) {
+    return false;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+
+  if (now < m_next_server_load_check) {
+    return false;
+  }
+
+  m_next_server_load_check = now + std::chrono::seconds(5);
+
+  std::string reason;
+
+  try {
+    reason = server_load_exceeded(m_session.get(), m_options,
+                                  m_num_threads_loading.load() +
+                                      m_num_threads_recreating_indexes.load());
+  } catch (const std::exception &e) {
+    log_warning("Unable to check the load of the server: %s", e.what());
+    return false;
+  }
+
+  const size_t max_tasks = m_options.threads_count();
+
+  if (!reason.empty()) {
+    if (m_max_load_tasks > 1) {
+      m_max_load_tasks = std::max<size_t>(1, m_max_load_tasks / 2);
+
+      current_console()->print_note(shcore::str_format(
+          "%s, reducing the number of threads loading data to %zu.",
+          reason.c_str(), m_max_load_tasks));
+    }
+
+    return false;
+  }
+
+  if (m_max_load_tasks < max_tasks) {
+    ++m_max_load_tasks;
+
+    log_info("Server load is back within limits, using %zu threads to load "
+             "data.",
+             m_max_load_tasks);
+
+    return true;
+  }
+
+  return false;
+}
+
 bool Dump_loader::wait_for_more_data() {
   const auto start_time = std::chrono::steady_clock::now();
   bool waited = false;
@@ -1638,7 +2167,11 @@ bool Dump_loader::wait_for_more_data() {
                                         m_options.dump_wait_timeout()) &&
                            !m_worker_interrupt;
            j++) {
-        shcore::sleep_ms(1000);
+        if (m_memory_dump) {
+          if (m_memory_dump->wait_for_files(std::chrono::seconds(1))) break;
+        } else {
+          shcore::sleep_ms(1000);
+        }
       }
     }
   }
@@ -1701,6 +2234,66 @@ void Dump_loader::on_chunk_load_end(const std::string &schema,
             std::to_string(raw_bytes_loaded).c_str());
 }
 
+void Dump_loader::on_sub_chunk_load_start(const std::string &schema,
+                                          const std::string &table,
+                                          ssize_t index,
+                                          const import_table::Range &range) {
+  auto &chunk = m_split_chunks[schema_table_key(schema, table) + ":" +
+                               std::to_string(index)];
+
+  if (!chunk.started) {
+    chunk.started = true;
+    m_load_log->start_table_chunk(schema, table, index);
+  }
+
+  m_load_log->start_table_sub_chunk(schema, table, index, range.begin,
+                                    range.end);
+}
+
+void Dump_loader::on_sub_chunk_load_end(const std::string &schema,
+                                        const std::string &table, ssize_t index,
+                                        const import_table::Range &range,
+                                        size_t bytes_loaded,
+                                        size_t raw_bytes_loaded) {
+  // bytes are recorded for each sub-chunk, so that sub-chunks which were
+  // loaded before the load was interrupted are also accounted for
+  m_load_log->end_table_sub_chunk(schema, table, index, range.begin,
+                                  range.end, bytes_loaded, raw_bytes_loaded);
+
+  log_debug("Ended loading sub-chunk [%zu, %zu) of `%s`.`%s`/%zi (%zu, %zu)",
+            range.begin, range.end, schema.c_str(), table.c_str(), index,
+            bytes_loaded, raw_bytes_loaded);
+
+  const auto key =
+      schema_table_key(schema, table) + ":" + std::to_string(index);
+
+  auto &chunk = m_split_chunks[key];
+
+  if (--chunk.pending == 0) {
+    const auto file = std::move(chunk.file);
+    m_split_chunks.erase(key);
+    ++m_num_chunks_loaded;
+    on_chunk_load_end(schema, table, index, 0, 0);
+    remove_data_file(file);
+  }
+}
+
+void Dump_loader::remove_data_file(const std::string &name) {
+  // files of an in-memory dump are released as soon as they are loaded
+  if (!m_options.remove_loaded_files() || m_options.dry_run()) {
+    return;
+  }
+
+  for (const auto &file : {name, name + ".idx"}) {
+    try {
+      m_dump->data_file(file)->remove();
+    } catch (const std::exception &e) {
+      log_warning("Could not remove loaded file %s: %s", file.c_str(),
+                  e.what());
+    }
+  }
+}
+
 void Dump_loader::Sql_transform::add_strip_removed_sql_modes() {
   // Remove NO_AUTO_CREATE_USER from sql_mode, which doesn't exist in 8.0 but
   // does in 5.7
@@ -25,6 +25,8 @@
 #define MODULES_UTIL_LOAD_DUMP_LOADER_H_
 
 #include <atomic>
+#include <chrono>
+#include <deque>
 #include <list>
 #include <memory>
 #include <regex>
@@ -39,8 +41,10 @@
 #include "modules/util/load/load_dump_options.h"
 #include "mysqlshdk/include/shellcore/scoped_contexts.h"
 #include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/storage/backend/memory_directory.h"
 #include "mysqlshdk/libs/storage/ifile.h"
 #include "mysqlshdk/libs/textui/text_progress.h"
+#include "mysqlshdk/libs/utils/memory_budget.h"
 #include "mysqlshdk/libs/utils/synchronized_queue.h"
 
 namespace mysqlsh {
@@ -62,6 +66,12 @@ class Dump_loader {
 
   void interrupt();
 
+  /**
+   * Stops the load without waiting for more data, i.e. when the dump which is
+   * being loaded has failed.
+   */
+  void stop();
+
   void run();
 
  private:
@@ -94,12 +104,15 @@ class Dump_loader {
       Load_chunk_task(size_t id, const std::string &schema,
                       const std::string &table, ssize_t chunk_index,
                       std::unique_ptr<mysqlshdk::storage::IFile> file,
-                      shcore::Dictionary_t options, bool resume)
+                      shcore::Dictionary_t options, bool resume,
+                      const import_table::Range &range)
           : Task(id, schema, table),
             m_chunk_index(chunk_index),
+            m_filename(file->filename()),
             m_file(std::move(file)),
             m_options(options),
-            m_resume(resume) {}
+            m_resume(resume),
+            m_range(range) {}
 
       size_t bytes_loaded = 0;
       size_t raw_bytes_loaded = 0;
@@ -112,11 +125,22 @@ class Dump_loader {
 
       ssize_t chunk_index() const { return m_chunk_index; }
 
+      // only a range of the chunk file is loaded
+      bool is_sub_chunk() const { return m_range.end > 0; }
+
+      const import_table::Range &range() const { return m_range; }
+
+      const std::string &filename() const { return m_filename; }
+
      private:
+      void remove_from_tables_being_loaded(Dump_loader *loader) const;
+
       ssize_t m_chunk_index;
+      std::string m_filename;
       std::unique_ptr<mysqlshdk::storage::IFile> m_file;
       shcore::Dictionary_t m_options;
       bool m_resume = false;
+      import_table::Range m_range;
     };
 
     class Analyze_table_task : public Task {
@@ -133,6 +157,25 @@ class Dump_loader {
       std::vector<Dump_reader::Histogram> m_histograms;
     };
 
+    class Table_ddl_task : public Task {
+     public:
+      Table_ddl_task(size_t id, const std::string &schema,
+                     const std::string &table, const std::string &script,
+                     bool resuming, bool indexes_deferred)
+          : Task(id, schema, table),
+            m_script(script),
+            m_resuming(resuming),
+            m_indexes_deferred(indexes_deferred) {}
+
+      bool execute(const std::shared_ptr<mysqlshdk::db::mysql::Session> &,
+                   Worker *, Dump_loader *) override;
+
+     private:
+      std::string m_script;
+      bool m_resuming;
+      bool m_indexes_deferred;
+    };
+
     class Index_recreation_task : public Task {
      public:
       Index_recreation_task(size_t id, const std::string &schema,
@@ -153,8 +196,12 @@ class Dump_loader {
     void load_chunk_file(const std::string &schema, const std::string &table,
                          std::unique_ptr<mysqlshdk::storage::IFile> file,
                          ssize_t chunk_index, size_t chunk_size,
-                         const shcore::Dictionary_t &options, bool resuming);
+                         const shcore::Dictionary_t &options, bool resuming,
+                         const import_table::Range &range);
 
+    void execute_table_ddl(const std::string &schema, const std::string &table,
+                           const std::string &script, bool resuming,
+                           bool indexes_deferred);
     void recreate_indexes(const std::string &schema, const std::string &table,
                           const std::vector<std::string> &indexes);
     void analyze_table(const std::string &schema, const std::string &table,
@@ -189,6 +236,8 @@ class Dump_loader {
       FATAL_ERROR,
       LOAD_START,
       LOAD_END,
+      TABLE_DDL_START,
+      TABLE_DDL_END,
       INDEX_START,
       INDEX_END,
       ANALYZE_START,
@@ -202,6 +251,41 @@ class Dump_loader {
   using Name_and_file =
       std::pair<std::string, std::unique_ptr<mysqlshdk::storage::IFile>>;
 
+  // range of a large chunk file, loaded concurrently with other ranges
+  struct Sub_chunk {
+    std::string schema;
+    std::string table;
+    ssize_t chunk_index;
+    std::string file;
+    shcore::Dictionary_t options;
+    import_table::Range range;
+  };
+
+  // DDL of a table, executed by one of the workers
+  struct Table_ddl {
+    std::string schema;
+    std::string table;
+    std::string script;
+    bool resuming = false;
+    bool indexes_deferred = false;
+  };
+
+  // DDL of a view, executed once all the pending tables are created
+  struct View_ddl {
+    std::string schema;
+    std::string view;
+    std::string script;
+    bool done = false;
+    bool resuming = false;
+  };
+
+  // progress of a chunk which was split into sub-chunks
+  struct Split_chunk {
+    std::string file;
+    size_t pending = 0;
+    bool started = false;
+  };
+
   mysqlshdk::db::ISession *session() const { return m_options.base_session(); }
 
   void execute_tasks();
@@ -226,18 +310,37 @@ class Dump_loader {
   bool handle_indexes(const std::string &schema, const std::string &table,
                       std::string *script, bool fulltext_only,
                       bool check_recreated);
-  void handle_table(const std::string &schema, const std::string &table,
+  void handle_table(const std::shared_ptr<mysqlshdk::db::ISession> &session,
+                    const std::string &schema, const std::string &table,
                     const std::string &script, bool resuming,
                     bool indexes_deferred = false);
+  bool schedule_table_ddl(Worker *worker);
+  void handle_views();
   bool schedule_table_chunk(const std::string &schema, const std::string &table,
                             ssize_t chunk_index, Worker *worker,
                             std::unique_ptr<mysqlshdk::storage::IFile> file,
                             size_t size, shcore::Dictionary_t options,
                             bool resuming);
 
+  bool split_table_chunk(const std::string &schema, const std::string &table,
+                         ssize_t chunk_index, const std::string &file,
+                         size_t size, const shcore::Dictionary_t &options,
+                         bool resuming);
+  bool schedule_sub_chunk(Worker *worker);
+
+  void remove_data_file(const std::string &name);
+
   bool schedule_next_task(Worker *worker);
   size_t handle_worker_events();
 
+  /**
+   * Checks the metrics of the target server and adjusts the number of workers
+   * which are allowed to load data at the same time.
+   *
+   * @returns true if more workers are allowed to load data than before.
+   */
+  bool check_server_load();
+
   void check_existing_objects();
   bool report_duplicates(const std::string &what, const std::string &schema,
                          mysqlshdk::db::IResult *result);
@@ -259,6 +362,14 @@ class Dump_loader {
                          ssize_t index, size_t bytes_loaded,
                          size_t raw_bytes_loaded);
 
+  void on_sub_chunk_load_start(const std::string &schema,
+                               const std::string &table, ssize_t index,
+                               const import_table::Range &range);
+  void on_sub_chunk_load_end(const std::string &schema,
+                             const std::string &table, ssize_t index,
+                             const import_table::Range &range,
+                             size_t bytes_loaded, size_t raw_bytes_loaded);
+
   friend class Worker;
   friend class Worker::Load_chunk_task;
 
@@ -279,6 +390,7 @@ class Dump_loader {
  private:
 #ifdef FRIEND_TEST
   FRIEND_TEST(Load_dump, sql_transforms_strip_sql_mode);
+  FRIEND_TEST(Load_dump, split_chunk_counted_once);
 #endif
 
   class Sql_transform {
@@ -311,6 +423,8 @@ class Dump_loader {
   const Load_dump_options &m_options;
 
   std::unique_ptr<Dump_reader> m_dump;
+  // directory of an in-memory dump, owned by m_dump
+  mysqlshdk::storage::backend::Memory_directory *m_memory_dump = nullptr;
   std::unique_ptr<Load_progress_log> m_load_log;
   bool m_resuming = false;
 
@@ -322,8 +436,22 @@ class Dump_loader {
 
   std::mutex m_tables_being_loaded_mutex;
   std::unordered_multimap<std::string, size_t> m_tables_being_loaded;
+  std::deque<Sub_chunk> m_pending_sub_chunks;
+  std::deque<Table_ddl> m_pending_table_ddl;
+  std::deque<View_ddl> m_pending_view_ddl;
+  // table DDL tasks scheduled, views are created once this drops to zero
+  size_t m_num_table_ddl_tasks = 0;
+  std::unordered_map<std::string, Split_chunk> m_split_chunks;
   std::atomic<size_t> m_num_threads_loading;
   std::atomic<size_t> m_num_threads_recreating_indexes;
+  // index recreation tasks scheduled, limited by the indexThreads option
+  size_t m_num_index_tasks = 0;
+  // data load tasks scheduled, limited when the server is under pressure
+  size_t m_num_load_tasks = 0;
+  size_t m_max_load_tasks = 0;
+  std::chrono::steady_clock::time_point m_next_server_load_check;
+  // memory used by all workers to read data ahead, not set if there's no limit
+  std::unique_ptr<mysqlshdk::utils::Memory_budget> m_memory_budget;
 
   Sql_transform m_default_sql_transforms;
 
@@ -354,6 +482,8 @@ class Dump_loader {
   std::atomic<size_t> m_num_chunks_loaded;
   std::atomic<size_t> m_num_warnings;
   std::atomic<size_t> m_num_errors;
+  std::atomic<size_t> m_num_indexes_recreated;
+  std::atomic<uint64_t> m_index_recreation_ms;
 
   int m_progress_spin = 0;
 };
@@ -23,9 +23,13 @@
 
 #include "modules/util/load/dump_reader.h"
 #include <algorithm>
+#include <cstring>
 #include <numeric>
 #include <utility>
 #include "modules/util/dump/dump_utils.h"
+#include "mysqlshdk/libs/storage/backend/file.h"
+#include "mysqlshdk/libs/storage/compressed_file.h"
+#include "mysqlshdk/libs/utils/utils_net.h"
 #include "mysqlshdk/libs/utils/utils_lexing.h"
 #include "mysqlshdk/libs/utils/utils_path.h"
 #include "mysqlshdk/libs/utils/utils_string.h"
@@ -254,94 +258,80 @@ std::string Dump_reader::fetch_schema_script(const std::string &schema) const {
   return script;
 }
 
-// Proportional chunk scheduling
+// Size-aware chunk scheduling
 //
 // Multiple sessions writing to the same table mean they will be competing for
 // locks to be able to update indexes.
 // So to optimize performance, we try to have as many different tables loaded
-// at the same time as possible.
-// If there are more tables than threads, that means there will be a single
-// session per table.
-// But if there are more threads than tables, we need to distribute them
-// among tables. If we distribute the threads equally, then smaller tables
-// will finish sooner and bigger tables will take extra longer because
-// it will have more threads working. So our optimization goal must be to keep
-// as many different tables loading concurrently for as long as possible.
-// Thus, smaller tables must get fewer threads allocated so they take longer
-// to load, while bigger threads get more, with the hope that the total time
-// to load all tables is minimized.
+// at the same time as possible, and a table which is not being loaded by any
+// session is always preferred.
+// The total load time is bound by the table which finishes last, so tables
+// are picked longest-processing-time-first: the table with the most data left
+// to be loaded is started first, so that the biggest tables do not start late
+// and become the tail of the load.
+// If all tables are already being loaded (there are more threads than tables),
+// the next thread goes to the table with the most remaining data per thread
+// loading it, with the number of threads per table optionally capped to limit
+// the contention.
+// Chunks of a table chunked by its primary key hold consecutive ranges of the
+// key and are handed out in ascending order. If key order is preferred, such
+// tables are loaded by a single thread, so that the rows are always appended
+// to the end of the clustered index instead of causing page splits. They are
+// shared by multiple threads only if there's no other work available.
 std::unordered_set<Dump_reader::Table_info *>::iterator
-Dump_reader::schedule_chunk_proportionally(
+Dump_reader::schedule_chunk_by_size(
     const std::unordered_multimap<std::string, size_t> &tables_being_loaded,
-    std::unordered_set<Dump_reader::Table_info *> *tables_with_data) {
-  std::unordered_map<std::string, double> worker_weights;
-  std::vector<std::pair<std::unordered_set<Dump_reader::Table_info *>::iterator,
-                        double>>
-      candidate_weights;
-
-  // calc ratio of data being loaded per table / total data being loaded
-  double total_bytes_loading = std::accumulate(
-      tables_being_loaded.begin(), tables_being_loaded.end(), 0,
-      [](size_t size, const std::pair<std::string, size_t> &table_size) {
-        return size + table_size.second;
-      });
-
-  if (total_bytes_loading > 0) {
-    for (const auto &table : tables_being_loaded) {
-      worker_weights.emplace(table.first, table.second / total_bytes_loading);
-    }
-  }
-
-  // calc ratio of data available per table / total data available
-  double total_bytes_available =
-      std::accumulate(tables_with_data->begin(), tables_with_data->end(), 0,
-                      [](size_t size, Dump_reader::Table_info *table) {
-                        return size + table->bytes_available();
-                      });
-  if (total_bytes_available > 0) {
-    for (auto it = tables_with_data->begin(); it != tables_with_data->end();
-         ++it) {
-      candidate_weights.emplace_back(
-          it, (*it)->bytes_available() / total_bytes_available);
-    }
-  } else {
-    return tables_with_data->begin();
-  }
-
-  // pick a chunk from the table that has the biggest difference between both
-  double best_diff = 0;
-  std::unordered_set<Dump_reader::Table_info *>::iterator best =
-      tables_with_data->begin();
-
-  double best_unique_diff = 0;
-  std::unordered_set<Dump_reader::Table_info *>::iterator best_unique =
-      tables_with_data->end();
-
-  for (const auto &cand : candidate_weights) {
-    std::string key =
-        schema_table_key((*cand.first)->schema, (*cand.first)->table);
-    auto it = worker_weights.find(key);
-    if (it != worker_weights.end()) {
-      double d = cand.second - it->second;
-      if (d > best_diff) {
-        best_diff = d;
-        best = cand.first;
+    std::unordered_set<Dump_reader::Table_info *> *tables_with_data,
+    size_t max_threads_per_table, bool prefer_key_order) {
+  auto best = tables_with_data->end();
+  size_t best_size = 0;
+
+  auto best_shared = tables_with_data->end();
+  double best_shared_size = 0;
+
+  auto best_ordered = tables_with_data->end();
+  double best_ordered_size = 0;
+
+  for (auto it = tables_with_data->begin(); it != tables_with_data->end();
+       ++it) {
+    const auto key = schema_table_key((*it)->schema, (*it)->table);
+    const auto range = tables_being_loaded.equal_range(key);
+    // data which is being loaded still needs to be processed
+    const auto bytes_loading = std::accumulate(
+        range.first, range.second, static_cast<size_t>(0),
+        [](size_t size, const std::pair<const std::string, size_t> &table) {
+          return size + table.second;
+        });
+    const auto threads = static_cast<size_t>(
+        std::distance(range.first, range.second));
+    const auto remaining = (*it)->bytes_available() + bytes_loading;
+
+    if (0 == threads) {
+      if (best == tables_with_data->end() || remaining > best_size) {
+        best = it;
+        best_size = remaining;
       }
-    } else {
-      if (cand.second > best_diff) {
-        best_diff = cand.second;
-        best = cand.first;
-      }
-      if (cand.second > best_unique_diff) {
-        best_unique_diff = cand.second;
-        best_unique = cand.first;
+    } else if (0 == max_threads_per_table || threads < max_threads_per_table) {
+      const auto size = static_cast<double>(remaining) / (threads + 1);
+
+      if (prefer_key_order && (*it)->chunked &&
+          !(*it)->primary_index.empty()) {
+        if (best_ordered == tables_with_data->end() ||
+            size > best_ordered_size) {
+          best_ordered = it;
+          best_ordered_size = size;
+        }
+      } else if (best_shared == tables_with_data->end() ||
+                 size > best_shared_size) {
+        best_shared = it;
+        best_shared_size = size;
       }
     }
   }
 
-  if (best_unique != tables_with_data->end()) return best_unique;
+  if (best != tables_with_data->end()) return best;
 
-  return best;
+  return best_shared != tables_with_data->end() ? best_shared : best_ordered;
 }
 
 bool Dump_reader::next_table_chunk(
@@ -351,7 +341,9 @@ bool Dump_reader::next_table_chunk(
     std::unique_ptr<mysqlshdk::storage::IFile> *out_file,
     size_t *out_chunk_size, shcore::Dictionary_t *out_options) {
   auto iter =
-      schedule_chunk_proportionally(tables_being_loaded, &m_tables_with_data);
+      schedule_chunk_by_size(tables_being_loaded, &m_tables_with_data,
+                             m_options.max_threads_per_table(),
+                             m_options.load_in_primary_key_order());
 
   if (iter != m_tables_with_data.end()) {
     *out_chunked = (*iter)->chunked;
@@ -367,7 +359,7 @@ bool Dump_reader::next_table_chunk(
         *out_chunks_total = 0;
       (*iter)->chunks_consumed++;
 
-      *out_file = m_dir->file(dump::get_table_data_filename(
+      *out_file = data_file(dump::get_table_data_filename(
           (*iter)->basename, (*iter)->extension, *out_chunk_index,
           *out_chunk_index + 1 == *out_chunks_total));
 
@@ -379,7 +371,7 @@ bool Dump_reader::next_table_chunk(
 
       *out_chunk_size = (*iter)->available_chunk_sizes[0];
 
-      *out_file = m_dir->file(
+      *out_file = data_file(
           dump::get_table_data_filename((*iter)->basename, (*iter)->extension));
     }
     if (!(*iter)->has_data_available()) m_tables_with_data.erase(iter);
@@ -389,23 +381,128 @@ bool Dump_reader::next_table_chunk(
   return false;
 }
 
+std::unique_ptr<mysqlshdk::storage::IFile> Dump_reader::data_file(
+    const std::string &name) const {
+  auto file = m_dir->file(name);
+
+  // data files are renamed once they're fully written and are not modified
+  // afterwards, local ones can be safely mapped into memory
+  if (const auto local =
+          dynamic_cast<mysqlshdk::storage::backend::File *>(file.get())) {
+    local->use_memory_mapping(true);
+  }
+
+  return file;
+}
+
+std::vector<import_table::Range> Dump_reader::split_data_file(
+    const std::string &name, size_t size, size_t range_size) const {
+  auto compression = mysqlshdk::storage::Compression::NONE;
+
+  try {
+    compression = mysqlshdk::storage::from_extension(
+        std::get<1>(shcore::path::split_extension(name)));
+  } catch (...) {
+  }
+
+  // compressed files cannot be read starting at an arbitrary offset
+  if (mysqlshdk::storage::Compression::NONE != compression ||
+      size < 2 * range_size) {
+    return {};
+  }
+
+  const auto index = m_dir->file(name + ".idx");
+
+  if (!index->exists()) {
+    return {};
+  }
+
+  index->open(mysqlshdk::storage::Mode::READ);
+  const auto data = mysqlshdk::storage::read_file(index.get());
+  index->close();
+
+  return split_by_index(data, size, range_size);
+}
+
+std::vector<import_table::Range> Dump_reader::split_by_index(
+    const std::string &index, size_t size, size_t range_size) {
+  // index file holds offsets of every N-th row, followed by the total size of
+  // the data, offsets are stored in network byte order
+  const auto count = index.size() / sizeof(uint64_t);
+  std::vector<import_table::Range> ranges;
+
+  if (0 == count) {
+    return ranges;
+  }
+
+  const auto offset_at = [&index](size_t i) {
+    uint64_t offset = 0;
+    memcpy(&offset, index.data() + i * sizeof(uint64_t), sizeof(uint64_t));
+    return mysqlshdk::utils::network_to_host(offset);
+  };
+
+  // index is not complete, i.e. data is still being written
+  if (offset_at(count - 1) != size) {
+    return ranges;
+  }
+
+  size_t begin = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    const auto offset = offset_at(i);
+
+    if (offset < begin || offset > size) {
+      // corrupted index
+      return {};
+    }
+
+    if (offset - begin >= range_size) {
+      ranges.push_back({begin, static_cast<size_t>(offset)});
+      begin = offset;
+    }
+  }
+
+  if (begin < size) {
+    if (!ranges.empty() && size - begin < range_size / 2) {
+      // merge small leftover with the previous range
+      ranges.back().end = size;
+    } else {
+      ranges.push_back({begin, size});
+    }
+  }
+
+  if (ranges.size() < 2) {
+    ranges.clear();
+  }
+
+  return ranges;
+}
+
 bool Dump_reader::next_deferred_index(
     std::string *out_schema, std::string *out_table,
     std::vector<std::string> **out_indexes,
     const std::function<bool(const std::string &)> &load_finished) {
+  // largest tables first, they take the longest to have their indexes built
+  Table_info *next = nullptr;
+
   for (auto &schema : m_contents.schemas) {
     for (auto &table : schema.second->tables) {
-      if (!table.second->indexes_done && table.second->data_done() &&
+      if (table.second->ddl_done && !table.second->indexes_done &&
+          table.second->data_done() &&
+          (!next || table.second->data_size() > next->data_size()) &&
           load_finished(schema_table_key(schema.first, table.first))) {
-        table.second->indexes_done = true;
-        *out_schema = schema.second->schema;
-        *out_table = table.second->table;
-        *out_indexes = &table.second->indexes;
-        return true;
+        next = table.second.get();
       }
     }
   }
-  return false;
+
+  if (!next) return false;
+
+  next->indexes_done = true;
+  *out_schema = next->schema;
+  *out_table = next->table;
+  *out_indexes = &next->indexes;
+  return true;
 }
 
 bool Dump_reader::next_table_analyze(std::string *out_schema,
@@ -413,8 +510,8 @@ bool Dump_reader::next_table_analyze(std::string *out_schema,
                                      std::vector<Histogram> *out_histograms) {
   for (auto &schema : m_contents.schemas) {
     for (auto &table : schema.second->tables) {
-      if (table.second->data_done() && table.second->indexes_done &&
-          !table.second->analyze_done) {
+      if (table.second->ddl_done && table.second->data_done() &&
+          table.second->indexes_done && !table.second->analyze_done) {
         table.second->analyze_done = true;
         *out_schema = schema.second->schema;
         *out_table = table.second->table;
@@ -431,7 +528,8 @@ bool Dump_reader::data_available() const { return !m_tables_with_data.empty(); }
 bool Dump_reader::work_available() const {
   for (auto &schema : m_contents.schemas) {
     for (auto &table : schema.second->tables) {
-      if (table.second->data_done() && !table.second->analyze_done) {
+      if (table.second->ddl_done && table.second->data_done() &&
+          !table.second->analyze_done) {
         return true;
       }
     }
@@ -467,15 +565,48 @@ size_t Dump_reader::filtered_data_size() const {
 void Dump_reader::rescan() {
   using mysqlshdk::storage::IDirectory;
 
-  std::vector<IDirectory::File_info> files = m_dir->list_files();
-  std::unordered_map<std::string, size_t> file_by_name;
+  // once all the metadata is scanned, the only files which can still appear
+  // are data files of tables which are being dumped and the final metadata
+  std::unordered_set<std::string> prefixes;
+
+  if (m_contents.md_done && m_contents.ready()) {
+    prefixes.emplace("@.done.json");
+
+    for (const auto &s : m_contents.schemas) {
+      for (const auto &t : s.second->tables) {
+        if (t.second->has_data && !t.second->last_chunk_seen) {
+          prefixes.emplace(t.second->basename);
+        }
+      }
+    }
+  }
+
+  // remote storage returns a page of up to 1000 entries per listing request,
+  // listing each prefix separately is cheaper if there are fewer prefixes than
+  // pages needed to list the whole directory
+  constexpr size_t k_listing_page_size = 1000;
+
+  const bool list_prefixes =
+      !prefixes.empty() &&
+      prefixes.size() < m_files.size() / k_listing_page_size;
+
+  std::vector<IDirectory::File_info> files =
+      list_prefixes ? m_dir->filter_files(prefixes) : m_dir->list_files();
+
+  bool new_files = false;
+
   for (const auto &f : files) {
-    file_by_name[f.name] = f.size;
+    if (m_files.emplace(f.name, f.size).second) {
+      new_files = true;
+    }
   }
 
-  m_contents.rescan(m_dir.get(), file_by_name, this);
+  // nothing has changed since the last scan
+  if (!new_files) return;
 
-  if (file_by_name.count("@.done.json") > 0 &&
+  m_contents.rescan(m_dir.get(), m_files, this);
+
+  if (m_files.count("@.done.json") > 0 &&
       m_dump_status != Status::COMPLETE) {
     m_dump_status = Status::COMPLETE;
     m_contents.parse_done_metadata(m_dir.get());
@@ -513,6 +644,28 @@ void Dump_reader::add_deferred_indexes(const std::string &schema,
       idx.end());
 }
 
+void Dump_reader::on_table_ddl_end(const std::string &schema,
+                                   const std::string &table) {
+  const auto s = m_contents.schemas.find(schema);
+
+  if (s == m_contents.schemas.end()) {
+    throw std::runtime_error("Unable to find schema " + schema);
+  }
+
+  const auto t = s->second->tables.find(table);
+
+  if (t == s->second->tables.end()) {
+    throw std::runtime_error("Unable to find table " + table + " in schema " +
+                             schema);
+  }
+
+  t->second->ddl_done = true;
+
+  if (t->second->has_data_available()) {
+    m_tables_with_data.insert(t->second.get());
+  }
+}
+
 std::string Dump_reader::Table_info::script_name() const {
   return dump::get_table_filename(basename);
 }
@@ -608,7 +761,9 @@ void Dump_reader::Table_info::rescan_data(
         found_data = true;
       }
     } else {
-      for (size_t i = num_chunks; i < files.size(); i++) {
+      // files which were already loaded may have been removed, number of
+      // files cannot be used as a limit
+      for (size_t i = num_chunks;; i++) {
         auto it = files.find(
             dump::get_table_data_filename(basename, extension, i, false));
         if (it != files.end()) {
@@ -634,7 +789,7 @@ void Dump_reader::Table_info::rescan_data(
         }
       }
     }
-    if (found_data) reader->m_tables_with_data.insert(this);
+    if (found_data && ddl_done) reader->m_tables_with_data.insert(this);
   }
 }
 
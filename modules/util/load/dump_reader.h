@@ -32,6 +32,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
+#include "modules/util/import_table/chunk_file.h"
 #include "modules/util/import_table/dialect.h"
 #include "modules/util/load/load_dump_options.h"
 #include "mysqlshdk/libs/storage/idirectory.h"
@@ -102,6 +103,23 @@ class Dump_reader {
       std::unique_ptr<mysqlshdk::storage::IFile> *out_file,
       size_t *out_chunk_size, shcore::Dictionary_t *out_options);
 
+  /**
+   * Splits an uncompressed data file into row-aligned ranges of roughly the
+   * given size, using offsets stored in its index file.
+   *
+   * @param name name of the data file
+   * @param size size of the data file
+   * @param range_size requested size of a range
+   *
+   * @returns ranges of the file, empty if file cannot be split
+   */
+  std::vector<import_table::Range> split_data_file(const std::string &name,
+                                                   size_t size,
+                                                   size_t range_size) const;
+
+  std::unique_ptr<mysqlshdk::storage::IFile> data_file(
+      const std::string &name) const;
+
   struct Histogram {
     std::string column;
     size_t buckets;
@@ -128,6 +146,12 @@ class Dump_reader {
   void add_deferred_indexes(const std::string &schema, const std::string &table,
                             std::vector<std::string> &&indexes);
 
+  /**
+   * Marks DDL of the given table as executed, table data is not scheduled to
+   * be loaded before that.
+   */
+  void on_table_ddl_end(const std::string &schema, const std::string &table);
+
   enum class Status {
     INVALID,  // No dump or not enough data to start loading yet
     DUMPING,  // Dump is not done yet
@@ -171,6 +195,7 @@ class Dump_reader {
     bool md_seen = false;
     bool md_done = false;
     bool sql_seen = false;
+    bool ddl_done = false;
 
     shcore::Dictionary_t options = nullptr;
     std::vector<std::string> indexes;
@@ -207,6 +232,15 @@ class Dump_reader {
       return total;
     }
 
+    size_t data_size() const {
+      size_t total = 0;
+
+      for (const auto size : available_chunk_sizes) {
+        if (size > 0) total += size;
+      }
+      return total;
+    }
+
     bool data_done() const {
       return !has_data || (last_chunk_seen && chunks_consumed == num_chunks);
     }
@@ -300,16 +334,24 @@ class Dump_reader {
   Status m_dump_status = Status::INVALID;
   Dump_info m_contents;
 
+  // all files seen so far, used to detect new files
+  std::unordered_map<std::string, size_t> m_files;
+
   // Tables that are ready to be loaded
   std::unordered_set<Table_info *> m_tables_with_data;
 
   static std::unordered_set<Dump_reader::Table_info *>::iterator
-  schedule_chunk_proportionally(
+  schedule_chunk_by_size(
       const std::unordered_multimap<std::string, size_t> &tables_being_loaded,
-      std::unordered_set<Dump_reader::Table_info *> *tables_with_data);
+      std::unordered_set<Dump_reader::Table_info *> *tables_with_data,
+      size_t max_threads_per_table, bool prefer_key_order);
+
+  static std::vector<import_table::Range> split_by_index(
+      const std::string &index, size_t size, size_t range_size);
 
 #ifdef FRIEND_TEST
   FRIEND_TEST(Dump_scheduler, load_scheduler);
+  FRIEND_TEST(Dump_reader, split_by_index);
 #endif
 };
 
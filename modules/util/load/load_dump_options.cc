@@ -24,6 +24,8 @@
 #include "modules/util/load/load_dump_options.h"
 
 #include "modules/mod_utils.h"
+#include "mysqlshdk/libs/storage/utils.h"
+#include "mysqlshdk/libs/utils/strformat.h"
 
 namespace mysqlsh {
 
@@ -161,7 +163,16 @@ void Load_dump_options::set_options(const shcore::Dictionary_t &options) {
       .optional("ignoreVersion", &m_ignore_version)
       .optional("analyzeTables", &analyze_tables)
       .optional("deferTableIndexes", &defer_table_indexes)
-      .optional("loadIndexes", &m_load_indexes);
+      .optional("loadIndexes", &m_load_indexes)
+      .optional("indexThreads", &m_index_threads_count)
+      .optional("maxThreadsPerTable", &m_max_threads_per_table)
+      .optional("loadInPrimaryKeyOrder", &m_load_in_primary_key_order)
+      .optional("maxRate", &m_max_rate)
+      .optional("maxBytesPerTransaction", &m_max_bytes_per_transaction)
+      .optional("maxMemory", &m_max_memory)
+      .optional("maxThreadsRunning", &m_max_threads_running)
+      .optional("maxReplicationLag", &m_max_replication_lag)
+      .optional("maxHistoryListLength", &m_max_history_list_length);
 
   unpacker.unpack(&m_oci_options);
   unpacker.end();
@@ -232,6 +243,39 @@ void Load_dump_options::set_options(const shcore::Dictionary_t &options) {
                              "'all', 'fulltext', and 'off'.");
   }
 
+  if (m_index_threads_count < 0)
+    throw std::invalid_argument(
+        "Invalid value of 'indexThreads' option, expected a non-negative "
+        "integer.");
+
+  if (m_max_threads_per_table < 0)
+    throw std::invalid_argument(
+        "Invalid value of 'maxThreadsPerTable' option, expected a "
+        "non-negative integer.");
+
+  if (!m_max_rate.empty()) {
+    // validate the value, it's passed on to the chunk loading code as is
+    mysqlshdk::utils::expand_to_bytes(m_max_rate);
+  }
+
+  if (!m_max_bytes_per_transaction.empty()) {
+    constexpr size_t min_bytes_per_transaction = 4096;
+
+    if (mysqlshdk::utils::expand_to_bytes(m_max_bytes_per_transaction) <
+        min_bytes_per_transaction) {
+      throw std::invalid_argument(
+          "The value of 'maxBytesPerTransaction' option must be greater than "
+          "or equal to " +
+          std::to_string(min_bytes_per_transaction) + " bytes.");
+    }
+  }
+
+  if (!m_max_memory.empty() &&
+      0 == mysqlshdk::utils::expand_to_bytes(m_max_memory)) {
+    throw std::invalid_argument(
+        "The value of 'maxMemory' option must be greater than 0.");
+  }
+
   if (!m_load_indexes && m_defer_table_indexes == Defer_index_mode::OFF)
     throw std::invalid_argument(
         "'deferTableIndexes' option needs to be enabled when "
@@ -250,6 +294,11 @@ void Load_dump_options::set_options(const shcore::Dictionary_t &options) {
   }
 }
 
+bool Load_dump_options::remove_loaded_files() const {
+  return mysqlshdk::storage::utils::scheme_matches(
+      mysqlshdk::storage::utils::get_scheme(m_url), "memory");
+}
+
 std::unique_ptr<mysqlshdk::storage::IDirectory>
 Load_dump_options::create_dump_handle() const {
   if (!m_oci_options.os_bucket_name.get_safe().empty())
@@ -258,6 +307,12 @@ Load_dump_options::create_dump_handle() const {
     return mysqlshdk::storage::make_directory(m_url);
 }
 
+size_t Load_dump_options::max_memory() const {
+  return m_max_memory.empty()
+             ? 0
+             : mysqlshdk::utils::expand_to_bytes(m_max_memory);
+}
+
 std::unique_ptr<mysqlshdk::storage::IFile>
 Load_dump_options::create_progress_file_handle() const {
   if (m_progress_file.get_safe().empty())
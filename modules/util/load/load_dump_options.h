@@ -95,6 +95,49 @@ class Load_dump_options final {
 
   int64_t threads_count() const { return m_threads_count; }
 
+  const std::string &max_rate() const { return m_max_rate; }
+
+  const std::string &max_bytes_per_transaction() const {
+    return m_max_bytes_per_transaction;
+  }
+
+  /**
+   * Memory shared by all threads to buffer data read ahead of LOAD DATA,
+   * 0 if there's no limit.
+   */
+  size_t max_memory() const;
+
+  uint64_t max_threads_running() const { return m_max_threads_running; }
+
+  uint64_t max_replication_lag() const { return m_max_replication_lag; }
+
+  uint64_t max_history_list_length() const {
+    return m_max_history_list_length;
+  }
+
+  /**
+   * Data files of an in-memory dump are removed once loaded, to release the
+   * memory.
+   */
+  bool remove_loaded_files() const;
+
+  bool throttle_on_server_load() const {
+    return m_max_threads_running > 0 || m_max_replication_lag > 0 ||
+           m_max_history_list_length > 0;
+  }
+
+  size_t max_threads_per_table() const {
+    return static_cast<size_t>(m_max_threads_per_table);
+  }
+
+  bool load_in_primary_key_order() const {
+    return m_load_in_primary_key_order;
+  }
+
+  int64_t index_threads_count() const {
+    return m_index_threads_count > 0 ? m_index_threads_count : m_threads_count;
+  }
+
   uint64_t dump_wait_timeout() const { return m_wait_dump_timeout; }
 
   const std::string &character_set() const { return m_character_set; }
@@ -129,6 +172,15 @@ class Load_dump_options final {
  private:
   std::string m_url;
   int64_t m_threads_count = 4;
+  int64_t m_index_threads_count = 0;
+  int64_t m_max_threads_per_table = 0;
+  bool m_load_in_primary_key_order = false;
+  std::string m_max_rate;
+  std::string m_max_bytes_per_transaction;
+  std::string m_max_memory;
+  uint64_t m_max_threads_running = 0;
+  uint64_t m_max_replication_lag = 0;
+  uint64_t m_max_history_list_length = 0;
   bool m_show_progress = isatty(fileno(stdout)) ? true : false;
 
   mysqlshdk::oci::Oci_options m_oci_options;
@@ -25,6 +25,7 @@
 #define MODULES_UTIL_LOAD_SCHEMA_LOAD_PROGRESS_LOG_H_
 
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -50,16 +51,30 @@ class Load_progress_log final {
     uint64_t raw_bytes_completed;
   };
 
+  /**
+   * Creates a handle to the n-th (starting with 1) segment of the progress
+   * file.
+   */
+  using Segment_factory =
+      std::function<std::unique_ptr<mysqlshdk::storage::IFile>(size_t)>;
+
+  /**
+   * Opens the progress file, reading the progress of a previous load.
+   *
+   * Segment factory is meant for storage backends that do not support
+   * neither appending nor flushing partially written contents (e.g. REST
+   * based storage services). In that case, we write to an in-memory file
+   * and every time we need to flush, entries which were added since the
+   * previous flush are written to a new segment of the file. Once there are
+   * too many segments, they are merged back into the file.
+   */
   Progress_status init(std::unique_ptr<mysqlshdk::storage::IFile> file,
-                       bool dry_run, bool rewrite_on_flush) {
+                       bool dry_run, const Segment_factory &segment = {}) {
     mysqlshdk::storage::IFile *existing_file = file.get();
 
-    // rewrite_on_flush is meant for storage backends that do not support
-    // neither appending nor flushing partially written contents (e.g. REST
-    // based storage services). In that case, we write to an in-memory file
-    // and every time we need to flush, we rewrite the entire file remotely.
-    if (rewrite_on_flush) {
+    if (segment) {
       m_real_file = std::move(file);
+      m_segment = segment;
       auto mem_file =
           std::make_unique<mysqlshdk::storage::backend::Memory_file>("");
       m_memfile_contents = &mem_file->content();
@@ -78,6 +93,18 @@ class Load_progress_log final {
       data = mysqlshdk::storage::read_file(existing_file);
       existing_file->close();
 
+      while (m_segment) {
+        const auto next = m_segment(m_segments + 1);
+
+        if (!next->exists()) break;
+
+        next->open(mysqlshdk::storage::Mode::READ);
+        data += mysqlshdk::storage::read_file(next.get());
+        next->close();
+
+        ++m_segments;
+      }
+
       try {
         shcore::str_itersplit(
             data,
@@ -100,10 +127,15 @@ class Load_progress_log final {
                 if (entry->has_key("chunk"))
                   key += ":" + std::to_string(entry->get_int("chunk"));
 
+                if (entry->has_key("begin"))
+                  key += ":" + std::to_string(entry->get_uint("begin"));
+
                 auto iter = m_last_state.find(key);
                 if (iter == m_last_state.end() || !done) {
                   m_last_state.emplace(key, Status::INTERRUPTED);
-                } else {
+                } else if (iter->second != Status::DONE) {
+                  // entries may be repeated if load was interrupted while
+                  // segments were merged, completed work is counted once
                   if (entry->has_key("bytes"))
                     bytes_completed += entry->get_uint("bytes");
 
@@ -129,6 +161,7 @@ class Load_progress_log final {
     if (dry_run) {
       m_file.reset();
       m_real_file.reset();
+      m_segment = nullptr;
     } else {
       m_file->open(mysqlshdk::storage::Mode::WRITE);
       if (!data.empty()) {
@@ -141,6 +174,10 @@ class Load_progress_log final {
   }
 
   void reset_progress() {
+    if (m_segment) {
+      remove_segments();
+    }
+
     if (m_memfile_contents) {
       if (m_file) m_file->close();
 
@@ -148,6 +185,7 @@ class Load_progress_log final {
           std::make_unique<mysqlshdk::storage::backend::Memory_file>("");
       m_memfile_contents = &mem_file->content();
       m_file = std::move(mem_file);
+      m_memfile_flushed = 0;
     }
 
     if (m_real_file) {
@@ -194,6 +232,16 @@ class Load_progress_log final {
     return it->second;
   }
 
+  Status table_sub_chunk_status(const std::string &schema,
+                                const std::string &table, ssize_t chunk,
+                                size_t begin) const {
+    auto it = m_last_state.find("TABLE-DATA-RANGE:`" + schema + "`:`" +
+                                table + "`:" + std::to_string(chunk) + ":" +
+                                std::to_string(begin));
+    if (it == m_last_state.end()) return Status::PENDING;
+    return it->second;
+  }
+
   void start_schema_ddl(const std::string &schema) {
     if (schema_ddl_status(schema) != Status::DONE)
       log(false, "SCHEMA-DDL", schema, "");
@@ -238,10 +286,37 @@ class Load_progress_log final {
           raw_bytes_loaded);
   }
 
+  // sub-chunk is a row-aligned range [begin, end) of a chunk file
+  void start_table_sub_chunk(const std::string &schema,
+                             const std::string &table, ssize_t index,
+                             size_t begin, size_t end) {
+    if (table_sub_chunk_status(schema, table, index, begin) != Status::DONE)
+      log(false, schema, table, index, begin, end, 0, 0);
+  }
+
+  void end_table_sub_chunk(const std::string &schema, const std::string &table,
+                           ssize_t index, size_t begin, size_t end,
+                           size_t bytes_loaded, size_t raw_bytes_loaded) {
+    if (table_sub_chunk_status(schema, table, index, begin) != Status::DONE)
+      log(true, schema, table, index, begin, end, bytes_loaded,
+          raw_bytes_loaded);
+  }
+
  private:
+  // segments are merged once there are more of them, or once they're larger
+  // than the file, this limits both the number of objects and the amount of
+  // data written to the storage
+  static constexpr size_t k_max_segments = 1000;
+
   std::unique_ptr<mysqlshdk::storage::IFile> m_file;
   std::unique_ptr<mysqlshdk::storage::IFile> m_real_file;
   const std::string *m_memfile_contents = nullptr;
+  // number of bytes of the in-memory file which were written to the storage
+  size_t m_memfile_flushed = 0;
+
+  Segment_factory m_segment;
+  size_t m_segments = 0;
+  size_t m_segments_size = 0;
 
   std::unordered_map<std::string, Status> m_last_state;
 
@@ -289,17 +364,72 @@ class Load_progress_log final {
     }
   }
 
+  void log(bool end, const std::string &schema, const std::string &table,
+           ssize_t chunk_index, size_t begin, size_t end_offset,
+           size_t bytes_loaded, size_t raw_bytes_loaded) {
+    if (m_file) {
+      shcore::JSON_dumper json;
+
+      json.start_object();
+      json.append_string("op", "TABLE-DATA-RANGE");
+      json.append_bool("done", end);
+      json.append_string("schema", schema);
+      json.append_string("table", table);
+      json.append_int("chunk", chunk_index);
+      json.append_uint64("begin", begin);
+      json.append_uint64("end", end_offset);
+      if (end) {
+        json.append_uint64("bytes", bytes_loaded);
+        json.append_uint64("raw_bytes", raw_bytes_loaded);
+      }
+      json.end_object();
+
+      mysqlshdk::storage::fputs(json.str() + "\n", m_file.get());
+      flush();
+    }
+  }
+
   void flush() {
     if (m_file) {
       m_file->flush();
     }
     if (m_real_file) {
-      m_real_file->open(mysqlshdk::storage::Mode::WRITE);
-      m_real_file->write(m_memfile_contents->data(),
-                         m_memfile_contents->size());
-      m_real_file->close();
+      const auto size = m_memfile_contents->size();
+      const auto pending = size - m_memfile_flushed;
+
+      if (0 == pending) return;
+
+      if (0 == m_memfile_flushed || m_segments >= k_max_segments ||
+          m_segments_size + pending > m_memfile_flushed - m_segments_size) {
+        // rewrite the whole file, then remove the merged segments
+        write(m_real_file.get(), m_memfile_contents->data(), size);
+        remove_segments();
+      } else {
+        write(m_segment(++m_segments).get(),
+              m_memfile_contents->data() + m_memfile_flushed, pending);
+        m_segments_size += pending;
+      }
+
+      m_memfile_flushed = size;
     }
   }
+
+  void remove_segments() {
+    // segments are removed starting with the last one, if this is interrupted
+    // the remaining ones are still contiguous
+    for (; m_segments > 0; --m_segments) {
+      m_segment(m_segments)->remove();
+    }
+
+    m_segments_size = 0;
+  }
+
+  static void write(mysqlshdk::storage::IFile *file, const char *data,
+                    size_t size) {
+    file->open(mysqlshdk::storage::Mode::WRITE);
+    file->write(data, size);
+    file->close();
+  }
 };
 
 inline std::string to_string(Load_progress_log::Status status) {
@@ -23,8 +23,11 @@
 
 #include "modules/util/mod_util.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
 #include <vector>
 #include "modules/mod_utils.h"
 #include "modules/mysqlxtest_utils.h"
@@ -43,14 +46,17 @@
 #include "mysqlshdk/include/shellcore/base_session.h"
 #include "mysqlshdk/include/shellcore/console.h"
 #include "mysqlshdk/include/shellcore/interrupt_handler.h"
+#include "mysqlshdk/include/shellcore/shell_init.h"
 #include "mysqlshdk/include/shellcore/shell_options.h"
 #include "mysqlshdk/include/shellcore/utils_help.h"
 #include "mysqlshdk/libs/db/mysql/session.h"
 #include "mysqlshdk/libs/mysql/instance.h"
 #include "mysqlshdk/libs/oci/oci_setup.h"
+#include "mysqlshdk/libs/storage/backend/memory_directory.h"
 #include "mysqlshdk/libs/utils/document_parser.h"
 #include "mysqlshdk/libs/utils/profiling.h"
 #include "mysqlshdk/libs/utils/ssl_keygen.h"
+#include "mysqlshdk/libs/utils/strformat.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/libs/utils/utils_string.h"
 #include "rapidjson/document.h"
@@ -82,9 +88,15 @@ Util::Util(shcore::IShell_core *owner) : _shell_core(*owner) {
          "?options");
   expose("dumpInstance", &Util::dump_instance, "outputUrl", "?options");
   expose("loadDump", &Util::load_dump, "url", "?options");
+  expose("copySchemas", &Util::copy_schemas, "schemas", "connectionData",
+         "?options");
 }
 
 namespace {
+
+// default number of seconds copySchemas waits for the dump to write more files
+constexpr int64_t k_copy_wait_timeout = 3600;
+
 std::string format_upgrade_issue(const Upgrade_issue &problem) {
   std::stringstream ss;
   const char *item = "Schema";
@@ -644,50 +656,55 @@ REGISTER_HELP(UTIL_IMPORTJSON_DETAIL8,
               "field based on the ObjectID timestamp. Only valid if "
               "convertBsonOid is enabled.");
 REGISTER_HELP(UTIL_IMPORTJSON_DETAIL9,
+              "@li threads: int (default: 1) - number of threads used to parse "
+              "and insert the documents, each thread uses its own X Protocol "
+              "session. If more than one thread is used, documents are not "
+              "inserted in the order in which they appear in the file.");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL10,
               "The following options are valid only when convertBsonTypes is "
               "enabled. They are all boolean flags. ignoreRegexOptions is "
               "enabled by default, rest are disabled by default.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL10,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL11,
               "@li ignoreDate: disables conversion of BSON Date values");
 REGISTER_HELP(
-    UTIL_IMPORTJSON_DETAIL11,
+    UTIL_IMPORTJSON_DETAIL12,
     "@li ignoreTimestamp: disables conversion of BSON Timestamp values");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL12,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL13,
               "@li ignoreRegex: disables conversion of BSON Regex values.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL15,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL16,
               "@li ignoreRegexOptions: causes regex options to be ignored when "
               "processing a Regex BSON value. This option is only valid if "
               "ignoreRegex is disabled.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL13,
-              "@li ignoreBinary: disables conversion of BSON BinData values.");
 REGISTER_HELP(UTIL_IMPORTJSON_DETAIL14,
+              "@li ignoreBinary: disables conversion of BSON BinData values.");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL15,
               "@li decimalAsDouble: causes BSON Decimal values to be imported "
               "as double values.");
 
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL16,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL17,
               "If the schema is not provided, an active schema on the global "
               "session, if set, will be used.");
 
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL17,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL18,
               "The collection and the table options cannot be combined. If "
               "they are not provided, the basename of the file without "
               "extension will be used as target collection name.");
 
 REGISTER_HELP(
-    UTIL_IMPORTJSON_DETAIL18,
+    UTIL_IMPORTJSON_DETAIL19,
     "If the target collection or table does not exist, they are created, "
     "otherwise the data is inserted into the existing collection or table.");
 
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL19,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL20,
               "The tableColumn implies the use of the table option and cannot "
               "be combined "
               "with the collection option.");
 
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL20, "<b>BSON Data Type Processing.</b>");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL21,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL21, "<b>BSON Data Type Processing.</b>");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL22,
               "If only convertBsonOid is enabled, no conversion will be done "
               "on the rest of the BSON Data Types.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL22,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL23,
               "To use extractOidTime, it should be set to a name which will "
               "be used to insert an additional field into the main document. "
               "The value of the new field will be the timestamp obtained from "
@@ -695,12 +712,12 @@ REGISTER_HELP(UTIL_IMPORTJSON_DETAIL22,
               "ObjectID value associated to the '_id' field of the main "
               "document.");
 REGISTER_HELP(
-    UTIL_IMPORTJSON_DETAIL23,
+    UTIL_IMPORTJSON_DETAIL24,
     "NumberLong and NumberInt values will be converted to integer values.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL24,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL25,
               "NumberDecimal values are imported as strings, unless "
               "decimalAsDouble is enabled.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL25,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL26,
               "Regex values will be converted to strings containing the "
               "regular expression. The regular expression options are ignored "
               "unless ignoreRegexOptions is disabled. When ignoreRegexOptions "
@@ -748,15 +765,14 @@ REGISTER_HELP(UTIL_IMPORTJSON_THROWS12, "@li JSON document is ill-formed");
  * $(UTIL_IMPORTJSON_DETAIL6)
  * $(UTIL_IMPORTJSON_DETAIL7)
  * $(UTIL_IMPORTJSON_DETAIL8)
- *
  * $(UTIL_IMPORTJSON_DETAIL9)
+ *
  * $(UTIL_IMPORTJSON_DETAIL10)
  * $(UTIL_IMPORTJSON_DETAIL11)
  * $(UTIL_IMPORTJSON_DETAIL12)
  * $(UTIL_IMPORTJSON_DETAIL13)
  * $(UTIL_IMPORTJSON_DETAIL14)
  * $(UTIL_IMPORTJSON_DETAIL15)
- *
  * $(UTIL_IMPORTJSON_DETAIL16)
  *
  * $(UTIL_IMPORTJSON_DETAIL17)
@@ -777,6 +793,8 @@ REGISTER_HELP(UTIL_IMPORTJSON_THROWS12, "@li JSON document is ill-formed");
  *
  * $(UTIL_IMPORTJSON_DETAIL25)
  *
+ * $(UTIL_IMPORTJSON_DETAIL26)
+ *
  * $(UTIL_IMPORTJSON_THROWS)
  * $(UTIL_IMPORTJSON_THROWS1)
  * $(UTIL_IMPORTJSON_THROWS2)
@@ -806,12 +824,14 @@ void Util::import_json(const std::string &file,
   std::string collection;
   std::string table;
   std::string table_column;
+  int64_t threads = 1;
 
   shcore::Option_unpacker unpacker(options);
   unpacker.optional("schema", &schema);
   unpacker.optional("collection", &collection);
   unpacker.optional("table", &table);
   unpacker.optional("tableColumn", &table_column);
+  unpacker.optional("threads", &threads);
 
   shcore::Document_reader_options roptions;
   mysqlsh::unpack_json_import_flags(&unpacker, &roptions);
@@ -890,6 +910,7 @@ void Util::import_json(const std::string &file,
   importer.set_print_callback([](const std::string &msg) -> void {
     mysqlsh::current_console()->print(msg);
   });
+  importer.set_threads(threads);
 
   try {
     importer.load_from(roptions);
@@ -1010,7 +1031,7 @@ REGISTER_HELP_FUNCTION_TEXT(UTIL_IMPORTTABLE, R"*(
 Import table dump stored in filename to target table using LOAD DATA LOCAL
 INFILE calls in parallel connections.
 
-@param filename Path to file with user data
+@param filename Path or list of paths to files with user data
 @param options Optional dictionary with import options
 
 Scheme part of <b>filename</b> contains infomation about the transport backend.
@@ -1030,6 +1051,12 @@ in oci.profile and oci.configFile shell options.
 ociProfile and ociConfigFile options will override, respectively,
 oci.profile and oci.configFile shell options.
 
+If <b>filename</b> is a list of files, all of them are imported into the same
+target table. The name of a file can contain the '*' and '?' wildcard characters
+to import all the matching files from a local directory or from an OCI Object
+Storage bucket. Chunks of all the files are loaded in parallel by the same pool
+of threads.
+
 Options dictionary:
 @li <b>schema</b>: string (default: current shell active schema) - Name of
 target schema
@@ -1062,6 +1089,11 @@ bytesPerChunk (+ bytes to end of the row) in single LOAD DATA call. Unit
 suffixes, k - for Kilobytes (n * 1'000 bytes), M - for Megabytes (n * 1'000'000
 bytes), G - for Gigabytes (n * 1'000'000'000 bytes), bytesPerChunk="2k" - ~2
 kilobyte data chunk will send to the MySQL Server.
+@li <b>maxBytesPerTransaction</b>: string (minimum: "4096", default: not
+set) - Maximum number of bytes sent in a single LOAD DATA statement. Each file
+chunk is split into multiple statements, each one committed separately, which
+limits the size of transactions executed by the server. Supports the same unit
+suffixes as bytesPerChunk.
 @li <b>maxRate</b>: string (default: "0") - Limit data send throughput to
 maxRate in bytes per second per thread.
 maxRate="0" - no limit. Unit suffixes, k - for Kilobytes (n * 1'000 bytes),
@@ -1069,7 +1101,7 @@ M - for Megabytes (n * 1'000'000 bytes), G - for Gigabytes (n * 1'000'000'000
 bytes), maxRate="2k" - limit to 2 kilobytes per second.
 @li <b>showProgress</b>: bool (default: true if stdout is a tty, false
 otherwise) - Enable or disable import progress information.
-@li <b>skipRows</b>: int (default: 0) - Skip first n rows of the data in the
+@li <b>skipRows</b>: int (default: 0) - Skip first n rows of the data in each
 file. You can use this option to skip an initial header line containing column
 names.
 @li <b>dialect</b>: enum (default: "default") - Setup fields and lines options
@@ -1155,7 +1187,7 @@ Each parallel connection sets the following session variables:
  * Import table dump stored in filename to target table using LOAD DATA LOCAL
  * INFILE calls in parallel connections.
  *
- * @param filename Path to file with user data
+ * @param filename Path or list of paths to files with user data
  * @param options Optional dictionary with import options
  *
  * Scheme part of <b>filename</b> contains infomation about the transport
@@ -1175,6 +1207,12 @@ Each parallel connection sets the following session variables:
  * ociProfile and ociConfigFile options will override, respectively,
  * oci.profile and oci.configFile shell options.
  *
+ * If <b>filename</b> is a list of files, all of them are imported into the same
+ * target table. The name of a file can contain the '*' and '?' wildcard
+ * characters to import all the matching files from a local directory or from an
+ * OCI Object Storage bucket. Chunks of all the files are loaded in parallel by
+ * the same pool of threads.
+ *
  * Options dictionary:
  * @li <b>schema</b>: string (default: current shell active schema) - Name of
  * target schema
@@ -1208,6 +1246,11 @@ Each parallel connection sets the following session variables:
  * suffixes, k - for Kilobytes (n * 1'000 bytes), M - for Megabytes (n *
  * 1'000'000 bytes), G - for Gigabytes (n * 1'000'000'000 bytes),
  * bytesPerChunk="2k" - ~2 kilobyte data chunk will send to the MySQL Server.
+ * @li <b>maxBytesPerTransaction</b>: string (minimum: "4096", default: not
+ * set) - Maximum number of bytes sent in a single LOAD DATA statement. Each
+ * file chunk is split into multiple statements, each one committed separately,
+ * which limits the size of transactions executed by the server. Supports the
+ * same unit suffixes as bytesPerChunk.
  * @li <b>maxRate</b>: string (default: "0") - Limit data send throughput to
  * maxRate in bytes per second per thread.
  * maxRate="0" - no limit. Unit suffixes, k - for Kilobytes (n * 1'000 bytes),
@@ -1215,8 +1258,8 @@ Each parallel connection sets the following session variables:
  * bytes), maxRate="2k" - limit to 2 kilobytes per second.
  * @li <b>showProgress</b>: bool (default: true if stdout is a tty, false
  * otherwise) - Enable or disable import progress information.
- * @li <b>skipRows</b>: int (default: 0) - Skip first n rows of the data in the
- * file. You can use this option to skip an initial header line containing
+ * @li <b>skipRows</b>: int (default: 0) - Skip first n rows of the data in
+ * each file. You can use this option to skip an initial header line containing
  * column names.
  * @li <b>dialect</b>: enum (default: "default") - Setup fields and lines
  * options that matches specific data file format. Can be used as base dialect
@@ -1300,13 +1343,28 @@ Undefined Util::importTable(String filename, Dictionary options);
 #elif DOXYGEN_PY
 None Util::import_table(str filename, dict options);
 #endif
-void Util::import_table(const std::string &filename,
+void Util::import_table(const shcore::Value &filename,
                         const shcore::Dictionary_t &options) {
   using import_table::Import_table;
   using import_table::Import_table_options;
   using mysqlshdk::utils::format_bytes;
 
-  Import_table_options opt(filename, options);
+  std::vector<std::string> filenames;
+
+  if (shcore::String == filename.type) {
+    filenames.emplace_back(filename.get_string());
+  } else if (shcore::Array == filename.type) {
+    filenames = filename.to_string_vector();
+
+    if (filenames.empty()) {
+      throw shcore::Exception::argument_error("File list cannot be empty.");
+    }
+  } else {
+    throw shcore::Exception::argument_error(
+        "Argument #1 is expected to be a string or an array of strings.");
+  }
+
+  Import_table_options opt(filenames, options);
 
   auto shell_session = _shell_core.get_dev_session();
   if (!shell_session || !shell_session->is_open() ||
@@ -1338,9 +1396,12 @@ void Util::import_table(const std::string &filename,
   const auto filesize = opt.file_size();
   const bool thread_thrown_exception = importer.any_exception();
   if (thread_thrown_exception) {
-    console->print_error("Error occur while importing file '" +
-                         opt.full_path() + "' (" + format_bytes(filesize) +
-                         ")");
+    const auto files = opt.files_count();
+    console->print_error(
+        "Error occur while importing " +
+        (1 == files ? "file '" + opt.full_path() + "'"
+                    : std::to_string(files) + " files") +
+        " (" + format_bytes(filesize) + ")");
   } else {
     console->print_info(importer.import_summary());
   }
@@ -1431,15 +1492,54 @@ specified schemas from the dump. By default, all schemas are included.
 @li <b>includeTables</b>: array of strings (default not set) - Loads only the
 specified tables from the dump. Strings are in format schema.table or
 `schema`.`table`. By default, all tables from all schemas are included.
+@li <b>indexThreads</b>: int (default: same as threads) - Maximum number of
+threads used to recreate deferred indexes once the table data is loaded. Tables
+are processed in order of size, largest first.
 @li <b>loadData</b>: bool (default: true) - Loads table data from the dump.
 @li <b>loadDdl</b>: bool (default: true) - Executes DDL/SQL scripts in the
 dump.
 @li <b>loadIndexes</b>: bool (default: true) - use together with 
 ‘deferTableIndexes’ to control whether secondary indexes should be recreated
 at the end of the load. Useful when loading DDL and data separately.
+@li <b>loadInPrimaryKeyOrder</b>: bool (default: false) - If enabled, chunks
+of tables which were chunked using their primary key are preferably loaded by
+a single thread at a time, in ascending order of the key, reducing the number
+of page splits in the clustered index. This is not guaranteed: such tables are
+loaded by multiple threads if there is no other data to load, and parts of a
+large chunk may be loaded by multiple threads at the same time.
 @li <b>loadUsers</b>: bool (default: false) - Executes SQL scripts for user
 accounts, roles and grants contained in the dump. Note: statements for the
 current user will be skipped.
+@li <b>maxBytesPerTransaction</b>: string (minimum: "4096", default: not
+set) - Maximum number of bytes sent in a single LOAD DATA statement. Each chunk
+is split into multiple statements, each one committed separately, which limits
+the size of undo logs and replication lag caused by large chunks. Supports unit
+suffixes: k (kilobytes), M (megabytes), G (gigabytes).
+@li <b>maxHistoryListLength</b>: int (default: 0) - If greater than 0, the
+InnoDB history list length of the target server is checked periodically and the
+number of threads loading data is reduced while it exceeds this value.
+@li <b>maxMemory</b>: string (default: not set) - Maximum amount of memory
+used by all threads to buffer data which is read ahead of the LOAD DATA
+statements, i.e. downloaded or decompressed. Once the limit is reached, threads
+wait for the memory to be released, but each thread is always able to buffer
+a single block of data. Supports unit suffixes: k (kilobytes), M (megabytes), G
+(gigabytes).
+@li <b>maxRate</b>: string (default: "0") - Limit data send throughput to
+maxRate in bytes per second per thread.
+maxRate="0" - no limit. Unit suffixes, k - for Kilobytes (n * 1'000 bytes),
+M - for Megabytes (n * 1'000'000 bytes), G - for Gigabytes (n * 1'000'000'000
+bytes), maxRate="2k" - limit to 2 kilobytes per second.
+@li <b>maxReplicationLag</b>: int (default: 0) - If greater than 0 and the
+target server is a replica, its replication lag is checked periodically and the
+number of threads loading data is reduced while the lag in seconds exceeds this
+value.
+@li <b>maxThreadsPerTable</b>: int (default: 0) - Maximum number of threads
+loading data into the same table at the same time. Limits the contention when
+there are more threads than tables. If set to 0, there is no limit.
+@li <b>maxThreadsRunning</b>: int (default: 0) - If greater than 0, the
+Threads_running status variable of the target server is checked periodically and
+the number of threads loading data is reduced while it exceeds this value. The
+sessions used by the load itself are not counted.
 @li <b>progressFile</b>: path (default: @<server_uuid@>.progress) - Stores
 load progress information in the given local file path.
 @li <b>resetProgress</b>: bool (default: false) - Discards progress information
@@ -1869,4 +1969,234 @@ void Util::dump_instance(const std::string &directory,
   Dump_instance{opts}.run();
 }
 
+REGISTER_HELP_FUNCTION(copySchemas, util);
+REGISTER_HELP_FUNCTION_TEXT(UTIL_COPYSCHEMAS, R"*(
+Copies schemas from the current global session to another server.
+
+@param schemas List of schemas to be copied.
+@param connectionData Connection data of the target server.
+@param options Optional dictionary with the copy options.
+
+The schemas are dumped from the server the global session is connected to and
+loaded into the target server at the same time, without writing the dump to
+the disk. Dump files are kept in memory until they are loaded, files which were
+loaded are released.
+
+<b>The following options are supported:</b>
+@li <b>bufferSize</b>: string (default: "1G") - maximum amount of memory used
+to hold the data files which were not loaded yet, including the files which
+are being written. Dump is paused when this limit is reached. The value can
+use one of the following suffixes: k, M, G.
+@li <b>dumpOptions</b>: dictionary (default: not set) - options passed to
+<<<dumpSchemas>>>().
+@li <b>loadOptions</b>: dictionary (default: not set) - options passed to
+<<<loadDump>>>().
+
+The <b>bufferSize</b> limit can be exceeded only if none of the data files
+were completely written yet, i.e. if a single data file is larger than the
+limit. Metadata files are not accounted for.
+
+Dump files are released only once they are loaded, because of that the
+<<<loadDump>>>() options which cause some of the files to be skipped
+(<b>dryRun</b>, <b>loadData</b>: false, <b>includeSchemas</b>,
+<b>includeTables</b>, <b>excludeSchemas</b>, <b>excludeTables</b>) are not
+supported, the <<<dumpSchemas>>>() options should be used to select the
+objects to be copied. The <b>waitDumpTimeout</b> option defaults to 3600
+seconds, progress of the load is not saved unless the <b>progressFile</b>
+option is set.
+
+@throws ArgumentError in the following scenarios:
+@li If any of the input arguments contains an invalid value.
+
+@throws RuntimeError in the following scenarios:
+@li If there is no open global session.
+@li If the dump or the load fails.
+
+<b>Example</b>
+@code
+util.<<<copySchemas>>>(["sakila"], "root@target:3306", {"loadOptions": {"threads": 8}})
+@endcode
+)*");
+/**
+ * \ingroup util
+ *
+ * $(UTIL_COPYSCHEMAS_BRIEF)
+ *
+ * $(UTIL_COPYSCHEMAS)
+ */
+#if DOXYGEN_JS
+Undefined Util::copySchemas(List schemas, ConnectionData connectionData,
+                            Dictionary options);
+#elif DOXYGEN_PY
+None Util::copy_schemas(list schemas, ConnectionData connectionData,
+                        dict options);
+#endif
+void Util::copy_schemas(
+    const std::vector<std::string> &schemas,
+    const mysqlshdk::db::Connection_options &connection_data,
+    const shcore::Dictionary_t &options) {
+  const auto session = _shell_core.get_dev_session();
+
+  if (!session || !session->is_open()) {
+    throw std::runtime_error(
+        "An open session is required to perform this operation.");
+  }
+
+  std::string buffer_size = "1G";
+  shcore::Dictionary_t dump_options;
+  shcore::Dictionary_t load_options;
+
+  shcore::Option_unpacker(options)
+      .optional("bufferSize", &buffer_size)
+      .optional("dumpOptions", &dump_options)
+      .optional("loadOptions", &load_options)
+      .end();
+
+  const auto capacity = mysqlshdk::utils::expand_to_bytes(buffer_size);
+
+  if (0 == capacity) {
+    throw shcore::Exception::argument_error(
+        "The option 'bufferSize' cannot be set to 0.");
+  }
+
+  // copy the dictionaries, so that the ones given by the user are not modified
+  dump_options = dump_options ? std::make_shared<shcore::Value::Map_type>(
+                                    *dump_options)
+                              : shcore::make_dict();
+  load_options = load_options ? std::make_shared<shcore::Value::Map_type>(
+                                    *load_options)
+                              : shcore::make_dict();
+
+  if (!dump_options->has_key("showProgress")) {
+    // progress is reported by the load
+    dump_options->set("showProgress", shcore::Value::False());
+  }
+
+  // files are released once they are loaded, dump is blocked if the loader
+  // skips some of them
+  if (dump_options->has_key("dryRun") && dump_options->get_bool("dryRun")) {
+    throw shcore::Exception::argument_error(
+        "The 'dryRun' option is not supported by the dumpOptions.");
+  }
+
+  if (load_options->has_key("dryRun") && load_options->get_bool("dryRun")) {
+    throw shcore::Exception::argument_error(
+        "The 'dryRun' option is not supported by the loadOptions.");
+  }
+
+  if (load_options->has_key("loadData") &&
+      !load_options->get_bool("loadData")) {
+    throw shcore::Exception::argument_error(
+        "The 'loadData' option cannot be disabled in the loadOptions.");
+  }
+
+  for (const auto option : {"includeSchemas", "includeTables",
+                            "excludeSchemas", "excludeTables"}) {
+    if (load_options->has_key(option)) {
+      throw shcore::Exception::argument_error(
+          shcore::str_format("The '%s' option is not supported by the "
+                             "loadOptions, use the dumpOptions to select the "
+                             "objects to be copied.",
+                             option));
+    }
+  }
+
+  if (!load_options->has_key("waitDumpTimeout")) {
+    // dump is running concurrently, wait for it to produce more files
+    load_options->set("waitDumpTimeout", shcore::Value(k_copy_wait_timeout));
+  }
+
+  if (!load_options->has_key("progressFile")) {
+    // an in-memory copy cannot be resumed
+    load_options->set("progressFile", shcore::Value(""));
+  }
+
+  using mysqlshdk::storage::backend::Memory_directory;
+
+  static std::atomic<uint64_t> copy_id{0};
+  const auto name = "copy-" + std::to_string(++copy_id);
+  const auto url = "memory://" + name;
+
+  // only the data files are removed by the loader, metadata files are kept
+  // until the copy is finished and are not limited by the buffer
+  const auto contents = Memory_directory::register_contents(
+      name, capacity, [](const std::string &file) {
+        return !shcore::str_endswith(file, ".json") &&
+               !shcore::str_endswith(file, ".sql");
+      });
+  shcore::on_leave_scope unregister_contents(
+      [&name]() { Memory_directory::unregister_contents(name); });
+
+  using mysqlsh::dump::Dump_schemas;
+  using mysqlsh::dump::Dump_schemas_options;
+
+  Dump_schemas_options dump_opts{schemas, url};
+  dump_opts.set_options(dump_options);
+  dump_opts.set_session(session->get_core_session());
+
+  Load_dump_options load_opts(url);
+  load_opts.set_session(establish_mysql_session(
+      connection_data, current_shell_options()->get().wizards));
+  load_opts.set_options(load_options);
+  load_opts.validate();
+
+  // both objects need to be created in the main thread
+  Dump_schemas dumper{dump_opts};
+  Dump_loader loader(load_opts);
+
+  // failure of one side makes the other one fail as well, only the first
+  // error is reported
+  std::mutex error_mutex;
+  std::exception_ptr first_error;
+
+  const auto set_error = [&error_mutex, &first_error]() {
+    std::lock_guard<std::mutex> lock(error_mutex);
+
+    if (!first_error) {
+      first_error = std::current_exception();
+    }
+  };
+
+  std::thread dump_thread([&]() {
+    mysqlsh::Mysql_thread mysql_thread;
+
+    try {
+      dumper.run();
+    } catch (...) {
+      set_error();
+      loader.stop();
+      // wake up the load if it's still waiting for the dump to start
+      contents->shutdown();
+    }
+  });
+
+  {
+    shcore::Interrupt_handler intr_handler([&loader]() -> bool {
+      loader.interrupt();
+      return false;
+    });
+
+    current_console()->print_info(load_opts.target_import_info());
+
+    try {
+      if (contents->wait_for("@.json")) {
+        loader.run();
+      }
+    } catch (...) {
+      set_error();
+      // unblock the dump, it's going to fail when writing next file
+      contents->shutdown();
+    }
+  }
+
+  dump_thread.join();
+
+  try {
+    if (first_error) {
+      std::rethrow_exception(first_error);
+    }
+  }
+  CATCH_AND_TRANSLATE();
+}
+
 }  // namespace mysqlsh
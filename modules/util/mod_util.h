@@ -80,7 +80,7 @@ class SHCORE_PUBLIC Util : public shcore::Cpp_object_bridge,
 #elif DOXYGEN_PY
   None import_table(str filename, dict options);
 #endif
-  void import_table(const std::string &filename,
+  void import_table(const shcore::Value &filename,
                     const shcore::Dictionary_t &options);
 
 #if DOXYGEN_JS
@@ -90,6 +90,16 @@ class SHCORE_PUBLIC Util : public shcore::Cpp_object_bridge,
 #endif
   void load_dump(const std::string &url, const shcore::Dictionary_t &options);
 
+#if DOXYGEN_JS
+  Undefined copySchemas(List schemas, ConnectionData connectionData,
+                        Dictionary options);
+#elif DOXYGEN_PY
+  None copy_schemas(list schemas, ConnectionData connectionData, dict options);
+#endif
+  void copy_schemas(const std::vector<std::string> &schemas,
+                    const mysqlshdk::db::Connection_options &connection_data,
+                    const shcore::Dictionary_t &options);
+
 #if DOXYGEN_JS
   Undefined dumpSchemas(List schemas, String outputUrl, Dictionary options);
 #elif DOXYGEN_PY
@@ -24,6 +24,7 @@
 #include "mysqlshdk/libs/db/mysql/result.h"
 
 #include <cstdlib>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
@@ -233,6 +234,43 @@ const IRow *Result::fetch_one() {
   return nullptr;
 }
 
+const Result::Raw_row *Result::fetch_one_raw() {
+  if (_pre_fetched) {
+    throw std::logic_error("Raw access to buffered rows is not supported");
+  }
+
+  if (!has_resultset()) {
+    return nullptr;
+  }
+
+  const auto res = _result.lock();
+
+  if (!res) {
+    return nullptr;
+  }
+
+  const MYSQL_ROW mysql_row = mysql_fetch_row(res.get());
+
+  if (!mysql_row) {
+    if (auto session = _session.lock()) {
+      int code = 0;
+      const char *state;
+      const char *err = session->get_last_error(&code, &state);
+      if (code != 0) throw mysqlshdk::db::Error(err, code, state);
+    }
+
+    return nullptr;
+  }
+
+  _raw_row.data = mysql_row;
+  _raw_row.lengths = mysql_fetch_lengths(res.get());
+
+  // Each read row increases the count
+  _fetched_row_count++;
+
+  return &_raw_row;
+}
+
 bool Result::next_resultset() {
   bool ret_val = false;
 
@@ -50,8 +50,28 @@ class SHCORE_PUBLIC Result : public mysqlshdk::db::IResult,
  public:
   virtual ~Result();
 
+  /**
+   * Raw data of a row, as returned by the client library.
+   */
+  struct Raw_row {
+    // values of the fields, nullptr if value is NULL
+    const char *const *data = nullptr;
+    const unsigned long *lengths = nullptr;
+  };
+
   // Data Retrieving
   virtual const IRow *fetch_one();
+
+  /**
+   * Fetches the next row without wrapping it in the IRow interface, field
+   * values can be accessed directly, without any virtual calls or validation.
+   *
+   * Data is valid until the next fetch. Not available if rows were buffered
+   * using buffer().
+   *
+   * @returns the row or nullptr if there are no more rows
+   */
+  const Raw_row *fetch_one_raw();
   virtual bool next_resultset();
   virtual std::unique_ptr<Warning> fetch_one_warning();
 
@@ -96,6 +116,7 @@ class SHCORE_PUBLIC Result : public mysqlshdk::db::IResult,
   std::weak_ptr<mysqlshdk::db::mysql::Session_impl> _session;
   std::vector<Column> _metadata;
   std::unique_ptr<Row> _row;
+  Raw_row _raw_row;
   std::weak_ptr<MYSQL_RES> _result;
   std::vector<std::string> _gtids;
   mutable std::shared_ptr<Field_names> _field_names;
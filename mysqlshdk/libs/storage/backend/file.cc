@@ -31,10 +31,13 @@
 #if defined(_WIN32)
 #include <io.h>
 #else
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <utility>
 
 #include "mysqlshdk/libs/storage/utils.h"
@@ -135,8 +138,54 @@ void File::open(Mode m) {
                              "': " + shcore::errno_to_string(errno));
   }
 #endif  // !USE_UNBUFFERED_FILES
+
+#ifndef _WIN32
+  if (Mode::READ == m && m_use_memory_mapping) {
+    map_file();
+  }
+#endif  // !_WIN32
+}
+
+#ifndef _WIN32
+void File::map_file() {
+#ifdef USE_UNBUFFERED_FILES
+  const int fd = m_fd;
+#else
+  const int fd = fileno(m_file);
+#endif
+
+  struct stat st;
+
+  if (0 != fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+      static_cast<uint64_t>(st.st_size) > std::numeric_limits<size_t>::max()) {
+    return;
+  }
+
+  const size_t size = static_cast<size_t>(st.st_size);
+  void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  if (MAP_FAILED == mapped) {
+    return;
+  }
+
+  // files are read sequentially, kernel can read ahead more aggressively
+  madvise(mapped, size, MADV_SEQUENTIAL);
+
+  m_mapped = static_cast<const char *>(mapped);
+  m_mapped_size = size;
+  m_mapped_offset = 0;
 }
 
+void File::unmap_file() {
+  if (is_mapped()) {
+    munmap(const_cast<char *>(m_mapped), m_mapped_size);
+    m_mapped = nullptr;
+    m_mapped_size = 0;
+    m_mapped_offset = 0;
+  }
+}
+#endif  // !_WIN32
+
 bool File::is_open() const {
 #ifdef USE_UNBUFFERED_FILES
   return m_fd >= 0;
@@ -156,6 +205,10 @@ int File::error() const {
 void File::close() { do_close(); }
 
 void File::do_close() {
+#ifndef _WIN32
+  unmap_file();
+#endif  // !_WIN32
+
 #ifdef USE_UNBUFFERED_FILES
 
   if (m_fd >= 0) {
@@ -181,6 +234,18 @@ std::string File::full_path() const { return m_filepath; }
 
 off64_t File::seek(off64_t offset) {
   assert(is_open());
+
+#ifndef _WIN32
+  if (is_mapped()) {
+    if (offset < 0) {
+      return -1;
+    }
+
+    m_mapped_offset = static_cast<size_t>(offset);
+    return offset;
+  }
+#endif  // !_WIN32
+
 #ifdef USE_UNBUFFERED_FILES
 
 #if defined(_WIN32)
@@ -204,6 +269,13 @@ off64_t File::seek(off64_t offset) {
 
 off64_t File::tell() const {
   assert(is_open());
+
+#ifndef _WIN32
+  if (is_mapped()) {
+    return m_mapped_offset;
+  }
+#endif  // !_WIN32
+
 #ifdef USE_UNBUFFERED_FILES
 
 #if defined(_WIN32)
@@ -228,6 +300,19 @@ off64_t File::tell() const {
 ssize_t File::read(void *buffer, size_t length) {
   assert(is_open());
 
+#ifndef _WIN32
+  if (is_mapped()) {
+    if (m_mapped_offset >= m_mapped_size) {
+      return 0;
+    }
+
+    const size_t bytes = std::min(length, m_mapped_size - m_mapped_offset);
+    memcpy(buffer, m_mapped + m_mapped_offset, bytes);
+    m_mapped_offset += bytes;
+    return bytes;
+  }
+#endif  // !_WIN32
+
 #ifdef USE_UNBUFFERED_FILES
 
 #ifdef _WIN32
@@ -64,9 +64,31 @@ class File : public IFile {
   void rename(const std::string &new_name) override;
   void remove() override;
 
+  /**
+   * Files opened for reading after this is enabled are mapped into memory,
+   * reads are then served from the mapping without any system calls. Disabled
+   * by default: if a mapped file is truncated while it's being read, accessing
+   * the removed pages raises SIGBUS, this should only be enabled for files
+   * which are not going to be modified while they are open. Ignored on
+   * Windows.
+   */
+  void use_memory_mapping(bool use) { m_use_memory_mapping = use; }
+
  private:
   void do_close();
 
+#ifndef _WIN32
+  /**
+   * Maps the whole file opened for reading into memory. If file cannot be
+   * mapped (i.e. it's not a regular file), it's read as usual.
+   */
+  void map_file();
+
+  void unmap_file();
+
+  bool is_mapped() const { return nullptr != m_mapped; }
+#endif  // !_WIN32
+
 #ifdef USE_UNBUFFERED_FILES
   int m_fd = -1;
   int m_error = 0;
@@ -74,6 +96,13 @@ class File : public IFile {
   FILE *m_file = nullptr;
 #endif
 
+#ifndef _WIN32
+  const char *m_mapped = nullptr;
+  size_t m_mapped_size = 0;
+  size_t m_mapped_offset = 0;
+#endif  // !_WIN32
+
+  bool m_use_memory_mapping = false;
   std::string m_filepath;
 };
 
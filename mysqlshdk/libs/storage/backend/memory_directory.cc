@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/libs/storage/backend/memory_directory.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace mysqlshdk {
+namespace storage {
+namespace backend {
+
+namespace {
+
+constexpr auto k_scheme = "memory://";
+
+std::mutex g_registry_mutex;
+std::unordered_map<std::string, std::shared_ptr<Memory_directory::Contents>>
+    g_registry;
+
+class Memory_directory_file : public IFile {
+ public:
+  Memory_directory_file() = delete;
+
+  Memory_directory_file(
+      const std::string &directory, const std::string &name,
+      const std::shared_ptr<Memory_directory::Contents> &contents)
+      : m_directory(directory), m_name(name), m_contents(contents) {}
+
+  Memory_directory_file(const Memory_directory_file &other) = delete;
+  Memory_directory_file(Memory_directory_file &&other) = delete;
+
+  Memory_directory_file &operator=(const Memory_directory_file &other) =
+      delete;
+  Memory_directory_file &operator=(Memory_directory_file &&other) = delete;
+
+  // data which was written but not closed is discarded
+  ~Memory_directory_file() override { discard(); }
+
+  void open(Mode m) override {
+    discard();
+    m_offset = 0;
+
+    if (Mode::READ == m) {
+      m_data = m_contents->get(m_name);
+
+      if (!m_data) {
+        throw std::runtime_error("Cannot open file '" + full_path() +
+                                 "': No such file or directory");
+      }
+    } else {
+      m_writing = true;
+      m_buffer.clear();
+
+      if (Mode::APPEND == m) {
+        if (const auto data = m_contents->get(m_name)) {
+          m_buffer = *data;
+        }
+
+        m_offset = m_buffer.size();
+      }
+    }
+  }
+
+  bool is_open() const override { return m_writing || m_data; }
+
+  int error() const override { return 0; }
+
+  void close() override {
+    if (m_writing) {
+      const auto reserved = m_reserved;
+      m_writing = false;
+      m_reserved = 0;
+      m_contents->put(m_name, std::move(m_buffer), reserved);
+      m_buffer.clear();
+    }
+
+    m_data.reset();
+  }
+
+  size_t file_size() const override {
+    if (m_writing) {
+      return m_buffer.size();
+    } else if (m_data) {
+      return m_data->size();
+    } else if (const auto data = m_contents->get(m_name)) {
+      return data->size();
+    } else {
+      return 0;
+    }
+  }
+
+  std::string full_path() const override {
+    return k_scheme + m_directory + "/" + m_name;
+  }
+
+  std::string filename() const override { return m_name; }
+
+  bool exists() const override { return m_contents->exists(m_name); }
+
+  off64_t seek(off64_t offset) override {
+    const auto size = static_cast<off64_t>(file_size());
+    m_offset = std::min(std::max<off64_t>(offset, 0), size);
+    return m_offset;
+  }
+
+  off64_t tell() const override { return m_offset; }
+
+  ssize_t read(void *buffer, size_t length) override {
+    if (!m_data) return -1;
+
+    const auto read = m_data->copy(static_cast<char *>(buffer), length,
+                                   static_cast<size_t>(m_offset));
+    m_offset += read;
+    return read;
+  }
+
+  ssize_t write(const void *buffer, size_t length) override {
+    if (!m_writing) return -1;
+
+    const auto offset = static_cast<size_t>(m_offset);
+
+    if (offset + length > m_buffer.size()) {
+      const auto bytes = offset + length - m_buffer.size();
+      m_contents->reserve(m_name, bytes);
+      m_reserved += bytes;
+    }
+
+    m_buffer.replace(offset, std::min(length, m_buffer.size() - offset),
+                     static_cast<const char *>(buffer), length);
+    m_offset += length;
+    return length;
+  }
+
+  bool flush() override { return true; }
+
+  void rename(const std::string &new_name) override {
+    // file which is still being written is stored under the new name
+    if (!m_writing) {
+      m_contents->rename(m_name, new_name);
+    }
+
+    m_name = new_name;
+  }
+
+  void remove() override { m_contents->remove(m_name); }
+
+ private:
+  void discard() {
+    if (m_writing) {
+      m_writing = false;
+      m_contents->release(m_reserved);
+      m_reserved = 0;
+      m_buffer.clear();
+    }
+  }
+
+  std::string m_directory;
+  std::string m_name;
+  std::shared_ptr<Memory_directory::Contents> m_contents;
+  std::shared_ptr<const std::string> m_data;
+  std::string m_buffer;
+  bool m_writing = false;
+  size_t m_reserved = 0;
+  off64_t m_offset = 0;
+};
+
+}  // namespace
+
+Memory_directory::Contents::Contents(size_t capacity, const Counted &counted)
+    : m_capacity(capacity),
+      m_counted(counted ? counted : [](const std::string &) { return true; }) {}
+
+bool Memory_directory::Contents::exists(const std::string &name) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_files.find(name) != m_files.end();
+}
+
+std::shared_ptr<const std::string> Memory_directory::Contents::get(
+    const std::string &name) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto it = m_files.find(name);
+  return m_files.end() == it ? nullptr : it->second;
+}
+
+void Memory_directory::Contents::reserve(const std::string &name,
+                                         size_t bytes) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  // if there are no counted files, nothing is going to be removed and waiting
+  // would block the writer forever
+  if (m_counted(name)) {
+    m_changed.wait(lock, [this, bytes]() {
+      return m_shutdown || 0 == m_size ||
+             m_size + m_reserved + bytes <= m_capacity;
+    });
+  }
+
+  if (m_shutdown) {
+    throw std::runtime_error("Cannot write file 'memory://" + name +
+                             "': directory is no longer available");
+  }
+
+  m_reserved += bytes;
+}
+
+void Memory_directory::Contents::release(size_t bytes) {
+  if (0 == bytes) return;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_reserved -= bytes;
+  m_changed.notify_all();
+}
+
+void Memory_directory::Contents::put(const std::string &name,
+                                     std::string &&data, size_t reserved) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_reserved -= reserved;
+
+  if (m_shutdown) {
+    m_changed.notify_all();
+    throw std::runtime_error("Cannot write file 'memory://" + name +
+                             "': directory is no longer available");
+  }
+
+  if (m_counted(name)) {
+    const auto it = m_files.find(name);
+
+    if (m_files.end() != it) {
+      m_size -= it->second->size();
+    }
+
+    m_size += data.size();
+  }
+
+  m_files[name] = std::make_shared<const std::string>(std::move(data));
+  ++m_stored;
+  m_changed.notify_all();
+}
+
+void Memory_directory::Contents::rename(const std::string &from,
+                                        const std::string &to) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto it = m_files.find(from);
+
+  if (m_files.end() == it) {
+    throw std::runtime_error("Cannot rename file 'memory://" + from +
+                             "': No such file or directory");
+  }
+
+  auto data = std::move(it->second);
+  m_files.erase(it);
+
+  if (m_counted(from)) {
+    m_size -= data->size();
+  }
+
+  if (m_counted(to)) {
+    const auto target = m_files.find(to);
+
+    if (m_files.end() != target) {
+      m_size -= target->second->size();
+    }
+
+    m_size += data->size();
+  }
+
+  m_files[to] = std::move(data);
+  ++m_stored;
+  m_changed.notify_all();
+}
+
+void Memory_directory::Contents::remove(const std::string &name) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto it = m_files.find(name);
+
+  if (m_files.end() != it) {
+    if (m_counted(name)) {
+      m_size -= it->second->size();
+    }
+
+    m_files.erase(it);
+    m_changed.notify_all();
+  }
+}
+
+std::vector<IDirectory::File_info> Memory_directory::Contents::list() const {
+  std::vector<IDirectory::File_info> files;
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  files.reserve(m_files.size());
+
+  for (const auto &file : m_files) {
+    files.push_back({file.first, file.second->size()});
+  }
+
+  return files;
+}
+
+bool Memory_directory::Contents::wait_for(const std::string &name) const {
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  m_changed.wait(lock, [this, &name]() {
+    return m_shutdown || m_files.find(name) != m_files.end();
+  });
+
+  return !m_shutdown;
+}
+
+uint64_t Memory_directory::Contents::stored() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stored;
+}
+
+uint64_t Memory_directory::Contents::wait_for_stored(
+    uint64_t stored, std::chrono::milliseconds timeout) const {
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  m_changed.wait_for(lock, timeout, [this, stored]() {
+    return m_shutdown || m_stored > stored;
+  });
+
+  return m_stored;
+}
+
+void Memory_directory::Contents::shutdown() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_shutdown = true;
+  m_changed.notify_all();
+}
+
+Memory_directory::Memory_directory(const std::string &name) : m_name(name) {
+  std::lock_guard<std::mutex> lock(g_registry_mutex);
+  const auto it = g_registry.find(m_name);
+
+  if (g_registry.end() != it) {
+    m_contents = it->second;
+    m_stored = m_contents->stored();
+  }
+}
+
+bool Memory_directory::exists() const { return nullptr != m_contents; }
+
+void Memory_directory::create() {
+  if (!m_contents) {
+    throw std::runtime_error("Cannot create directory '" + full_path() +
+                             "': memory directories need to be registered");
+  }
+}
+
+std::string Memory_directory::full_path() const { return k_scheme + m_name; }
+
+std::vector<IDirectory::File_info> Memory_directory::list_files(bool) const {
+  if (!m_contents) return {};
+
+  return m_contents->list();
+}
+
+std::unique_ptr<IFile> Memory_directory::file(const std::string &name) const {
+  if (!m_contents) {
+    throw std::runtime_error("Directory '" + full_path() + "' does not exist");
+  }
+
+  return std::make_unique<Memory_directory_file>(m_name, name, m_contents);
+}
+
+bool Memory_directory::wait_for_files(std::chrono::milliseconds timeout) {
+  if (!m_contents) return false;
+
+  const auto stored = m_contents->wait_for_stored(m_stored, timeout);
+  const auto result = stored > m_stored;
+  m_stored = stored;
+  return result;
+}
+
+std::string Memory_directory::join_path(const std::string &a,
+                                        const std::string &b) const {
+  return a + "/" + b;
+}
+
+std::shared_ptr<Memory_directory::Contents>
+Memory_directory::register_contents(const std::string &name, size_t capacity,
+                                    const Contents::Counted &counted) {
+  std::lock_guard<std::mutex> lock(g_registry_mutex);
+  auto &contents = g_registry[name];
+
+  if (contents) {
+    throw std::invalid_argument("Memory directory '" + name +
+                                "' is already registered");
+  }
+
+  contents = std::make_shared<Contents>(capacity, counted);
+  return contents;
+}
+
+void Memory_directory::unregister_contents(const std::string &name) {
+  std::lock_guard<std::mutex> lock(g_registry_mutex);
+  g_registry.erase(name);
+}
+
+}  // namespace backend
+}  // namespace storage
+}  // namespace mysqlshdk
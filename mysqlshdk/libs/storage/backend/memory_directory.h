@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MYSQLSHDK_LIBS_STORAGE_BACKEND_MEMORY_DIRECTORY_H_
+#define MYSQLSHDK_LIBS_STORAGE_BACKEND_MEMORY_DIRECTORY_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "mysqlshdk/libs/storage/idirectory.h"
+
+namespace mysqlshdk {
+namespace storage {
+namespace backend {
+
+/**
+ * Directory which holds its files in memory. All handles created for the same
+ * "memory://<name>" path share the same contents, which allows to load a dump
+ * while it's being written by another thread of the same process.
+ *
+ * A file which is being written becomes visible to other handles once it is
+ * closed. Memory is reserved while the data is written, writers are blocked
+ * when the capacity of the directory would be exceeded, until enough files are
+ * removed. Only the files which are eventually removed by the reader should be
+ * counted towards the capacity, as writers are not blocked if there are no such
+ * files (nothing would wake them up), in which case the capacity may be
+ * exceeded by the files which are being written.
+ */
+class Memory_directory : public IDirectory {
+ public:
+  class Contents {
+   public:
+    using Counted = std::function<bool(const std::string &)>;
+
+    Contents() = delete;
+
+    Contents(size_t capacity, const Counted &counted);
+
+    Contents(const Contents &other) = delete;
+    Contents(Contents &&other) = delete;
+
+    Contents &operator=(const Contents &other) = delete;
+    Contents &operator=(Contents &&other) = delete;
+
+    ~Contents() = default;
+
+    bool exists(const std::string &name) const;
+
+    std::shared_ptr<const std::string> get(const std::string &name) const;
+
+    /**
+     * Reserves memory for the data which is going to be written to the file,
+     * waits if the capacity of the directory would be exceeded.
+     *
+     * @throws std::runtime_error if contents were shut down
+     */
+    void reserve(const std::string &name, size_t bytes);
+
+    /**
+     * Releases memory which was reserved, but not stored.
+     */
+    void release(size_t bytes);
+
+    /**
+     * Stores the file.
+     *
+     * @param name Name of the file.
+     * @param data Contents of the file.
+     * @param reserved Memory reserved while the file was written.
+     *
+     * @throws std::runtime_error if contents were shut down
+     */
+    void put(const std::string &name, std::string &&data, size_t reserved);
+
+    void rename(const std::string &from, const std::string &to);
+
+    void remove(const std::string &name);
+
+    std::vector<IDirectory::File_info> list() const;
+
+    /**
+     * Waits until the given file is stored.
+     *
+     * @returns false if contents were shut down
+     */
+    bool wait_for(const std::string &name) const;
+
+    /**
+     * Number of times a file was stored in the directory.
+     */
+    uint64_t stored() const;
+
+    /**
+     * Waits until a file is stored, if less than the given number of files
+     * was stored so far, or until the timeout passes.
+     *
+     * @returns number of times a file was stored in the directory
+     */
+    uint64_t wait_for_stored(uint64_t stored,
+                             std::chrono::milliseconds timeout) const;
+
+    /**
+     * Wakes up all the waiting threads, no more files can be stored.
+     */
+    void shutdown();
+
+   private:
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_changed;
+    std::map<std::string, std::shared_ptr<const std::string>> m_files;
+    // size of the stored files which are counted towards the capacity
+    size_t m_size = 0;
+    // memory reserved by the files which are being written
+    size_t m_reserved = 0;
+    // number of times a file was stored
+    uint64_t m_stored = 0;
+    const size_t m_capacity;
+    const Counted m_counted;
+    bool m_shutdown = false;
+  };
+
+  Memory_directory() = delete;
+
+  /**
+   * Creates a handle to the directory, contents with the given name need to
+   * be registered first.
+   *
+   * @param name Name of the directory, without the "memory://" prefix.
+   */
+  explicit Memory_directory(const std::string &name);
+
+  Memory_directory(const Memory_directory &other) = delete;
+  Memory_directory(Memory_directory &&other) = default;
+
+  Memory_directory &operator=(const Memory_directory &other) = delete;
+  Memory_directory &operator=(Memory_directory &&other) = default;
+
+  ~Memory_directory() override = default;
+
+  bool exists() const override;
+
+  void create() override;
+
+  std::string full_path() const override;
+
+  std::vector<IDirectory::File_info> list_files(
+      bool hidden_files = false) const override;
+
+  std::unique_ptr<IFile> file(const std::string &name) const override;
+
+  /**
+   * Waits until a file is stored in the directory, or until the timeout
+   * passes. Files stored since the previous call (or since this handle was
+   * created) are reported immediately, so that a file which is stored while
+   * the directory is being listed is not missed.
+   *
+   * @returns true if a file was stored
+   */
+  bool wait_for_files(std::chrono::milliseconds timeout);
+
+  /**
+   * Registers contents of a directory with the given name.
+   *
+   * @param name Name of the directory.
+   * @param capacity Number of bytes the directory can hold before writers
+   *        are blocked.
+   * @param counted Tells if file with the given name counts towards the
+   *        capacity, all files are counted if not set.
+   *
+   * @throws std::invalid_argument if name is already registered
+   */
+  static std::shared_ptr<Contents> register_contents(
+      const std::string &name, size_t capacity,
+      const Contents::Counted &counted = {});
+
+  /**
+   * Unregisters contents of a directory with the given name, memory is
+   * released once all handles are destroyed.
+   */
+  static void unregister_contents(const std::string &name);
+
+ protected:
+  std::string join_path(const std::string &a,
+                        const std::string &b) const override;
+
+ private:
+  std::string m_name;
+  std::shared_ptr<Contents> m_contents;
+  uint64_t m_stored = 0;
+};
+
+}  // namespace backend
+}  // namespace storage
+}  // namespace mysqlshdk
+
+#endif  // MYSQLSHDK_LIBS_STORAGE_BACKEND_MEMORY_DIRECTORY_H_
@@ -25,6 +25,7 @@
 
 #include <iterator>
 #include <string>
+#include <utility>
 
 namespace mysqlshdk {
 namespace storage {
@@ -111,6 +112,8 @@ void Memory_file::remove() {}
 
 void Memory_file::set_content(const std::string &s) { m_content = s; }
 
+void Memory_file::set_content(std::string &&s) { m_content = std::move(s); }
+
 }  // namespace backend
 }  // namespace storage
 }  // namespace mysqlshdk
@@ -68,6 +68,7 @@ class Memory_file : public IFile {
   void remove() override;
 
   void set_content(const std::string &s);
+  void set_content(std::string &&s);
   const std::string &content() const { return m_content; }
 
  private:
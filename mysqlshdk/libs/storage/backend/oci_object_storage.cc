@@ -126,6 +126,28 @@ std::vector<IDirectory::File_info> Directory::list_files(
   return files;
 }
 
+std::vector<IDirectory::File_info> Directory::filter_files(
+    const std::unordered_set<std::string> &prefixes) const {
+  std::vector<IDirectory::File_info> files;
+  std::string prefix = m_name.empty() ? "" : m_name + "/";
+
+  for (const auto &name_prefix : prefixes) {
+    std::vector<mysqlshdk::oci::Object_details> objects;
+
+    try {
+      objects = m_bucket->list_objects(prefix + name_prefix, "", "", 0, false);
+    } catch (const Response_error &error) {
+      throw shcore::Exception::runtime_error(error.format());
+    }
+
+    for (const auto &object : objects) {
+      files.push_back({object.name.substr(prefix.size()), object.size});
+    }
+  }
+
+  return files;
+}
+
 std::string Directory::join_path(const std::string &a,
                                  const std::string &b) const {
   return a.empty() ? b : a + "/" + b;
@@ -102,6 +102,14 @@ class Directory : public mysqlshdk::storage::IDirectory {
    */
   std::vector<File_info> list_files(bool hidden_files = false) const override;
 
+  /**
+   * Retrieves a list of files with the given prefixes, each prefix is listed
+   * separately, so that the number of requests depends on the number of
+   * matching files and not on the number of all files in the directory.
+   */
+  std::vector<File_info> filter_files(
+      const std::unordered_set<std::string> &prefixes) const override;
+
   /**
    * Creates a new file handle for for a file contained on this directory.
    *
@@ -27,8 +27,10 @@
 
 #include "mysqlshdk/libs/oci/oci_options.h"
 #include "mysqlshdk/libs/storage/backend/directory.h"
+#include "mysqlshdk/libs/storage/backend/memory_directory.h"
 #include "mysqlshdk/libs/storage/backend/oci_object_storage.h"
 #include "mysqlshdk/libs/storage/utils.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
 
 namespace mysqlshdk {
 namespace storage {
@@ -37,6 +39,22 @@ std::unique_ptr<IFile> IDirectory::file(const std::string &name) const {
   return make_file(join_path(full_path(), name));
 }
 
+std::vector<IDirectory::File_info> IDirectory::filter_files(
+    const std::unordered_set<std::string> &prefixes) const {
+  std::vector<File_info> files;
+
+  for (auto &f : list_files()) {
+    for (const auto &prefix : prefixes) {
+      if (shcore::str_beginswith(f.name, prefix)) {
+        files.emplace_back(std::move(f));
+        break;
+      }
+    }
+  }
+
+  return files;
+}
+
 std::unique_ptr<IDirectory> make_directory(
     const std::string &path,
     const std::unordered_map<std::string, std::string> &options) {
@@ -55,6 +73,9 @@ std::unique_ptr<IDirectory> make_directory(
   const auto scheme = utils::get_scheme(path);
   if (scheme.empty() || utils::scheme_matches(scheme, "file")) {
     return std::make_unique<backend::Directory>(path);
+  } else if (utils::scheme_matches(scheme, "memory")) {
+    return std::make_unique<backend::Memory_directory>(
+        utils::strip_scheme(path, scheme));
   } else if (utils::scheme_matches(scheme, "oci+os")) {
     throw std::invalid_argument("The osBucketName option is missing.");
   }
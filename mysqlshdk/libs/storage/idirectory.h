@@ -27,6 +27,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "mysqlshdk/libs/storage/ifile.h"
@@ -67,6 +68,21 @@ class IDirectory {
   virtual std::vector<File_info> list_files(
       bool hidden_files = false) const = 0;
 
+  /**
+   * Lists files in this directory whose names start with any of the given
+   * prefixes. Hidden files are not included.
+   *
+   * Default implementation lists all the files and filters them, backends
+   * which are able to list files with a given prefix on their own should
+   * override it.
+   *
+   * @param prefixes Prefixes of the file names.
+   *
+   * @returns Matching files in this directory.
+   */
+  virtual std::vector<File_info> filter_files(
+      const std::unordered_set<std::string> &prefixes) const;
+
   /**
    * Provides handle to the file with the specified name in this directory.
    *
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/libs/storage/read_ahead_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace mysqlshdk {
+namespace storage {
+
+namespace {
+
+constexpr size_t k_max_block_size = 1024 * 1024;
+
+// how often the helper thread checks if consumer ran out of data while waiting
+// for the memory budget
+constexpr std::chrono::milliseconds k_budget_wait{10};
+
+}  // namespace
+
+Read_ahead_file::Read_ahead_file(std::unique_ptr<IFile> file,
+                                 size_t buffer_size,
+                                 utils::Memory_budget *budget)
+    : m_file(std::move(file)), m_budget(budget) {
+  // at least two blocks, so one can be filled while the other is consumed
+  const auto blocks = std::max<size_t>(
+      2, (buffer_size + k_max_block_size - 1) / k_max_block_size);
+
+  m_block_size = std::max<size_t>(1, buffer_size / blocks);
+  m_blocks.resize(blocks);
+}
+
+Read_ahead_file::~Read_ahead_file() { stop(); }
+
+void Read_ahead_file::open(Mode m) {
+  stop();
+  m_file->open(m);
+  m_offset = 0;
+}
+
+bool Read_ahead_file::is_open() const { return m_file->is_open(); }
+
+int Read_ahead_file::error() const { return m_file->error(); }
+
+void Read_ahead_file::close() {
+  stop();
+  m_file->close();
+}
+
+size_t Read_ahead_file::file_size() const { return m_file->file_size(); }
+
+std::string Read_ahead_file::full_path() const { return m_file->full_path(); }
+
+std::string Read_ahead_file::filename() const { return m_file->filename(); }
+
+bool Read_ahead_file::exists() const { return m_file->exists(); }
+
+off64_t Read_ahead_file::seek(off64_t offset) {
+  stop();
+
+  const auto result = m_file->seek(offset);
+
+  if (static_cast<off64_t>(-1) != result) {
+    m_offset = offset;
+  }
+
+  return result;
+}
+
+off64_t Read_ahead_file::tell() const { return m_offset; }
+
+ssize_t Read_ahead_file::read(void *buffer, size_t length) {
+  if (!m_reading) {
+    start();
+  }
+
+  auto out = static_cast<char *>(buffer);
+  size_t total = 0;
+
+  while (total < length) {
+    if (m_current && m_current->size <= 0) {
+      // EOF or an error, block is kept, so subsequent calls behave the same
+      if (m_current->size < 0) {
+        if (m_current->exception) {
+          std::rethrow_exception(m_current->exception);
+        }
+
+        return -1;
+      }
+
+      break;
+    }
+
+    if (!m_current ||
+        m_current->offset == static_cast<size_t>(m_current->size)) {
+      if (m_current) {
+        release(m_current);
+        m_free->push(m_current);
+      }
+
+      m_current = m_full->pop();
+      --m_ready;
+      continue;
+    }
+
+    const auto bytes =
+        std::min(length - total,
+                 static_cast<size_t>(m_current->size) - m_current->offset);
+
+    memcpy(out + total, m_current->data.get() + m_current->offset, bytes);
+    m_current->offset += bytes;
+    total += bytes;
+  }
+
+  m_offset += total;
+
+  return total;
+}
+
+ssize_t Read_ahead_file::write(const void *buffer, size_t length) {
+  return m_file->write(buffer, length);
+}
+
+bool Read_ahead_file::flush() { return m_file->flush(); }
+
+void Read_ahead_file::rename(const std::string &new_name) {
+  m_file->rename(new_name);
+}
+
+void Read_ahead_file::remove() { m_file->remove(); }
+
+void Read_ahead_file::start() {
+  m_free = std::make_unique<shcore::Synchronized_queue<Block *>>();
+  m_full = std::make_unique<shcore::Synchronized_queue<Block *>>();
+
+  for (auto &block : m_blocks) {
+    m_free->push(&block);
+  }
+
+  m_current = nullptr;
+  m_stop = false;
+  m_ready = 0;
+  m_thread = std::thread(&Read_ahead_file::read_ahead, this);
+  m_reading = true;
+}
+
+void Read_ahead_file::stop() {
+  if (!m_reading) {
+    return;
+  }
+
+  m_stop = true;
+  // wakes up the thread if it waits for a free block
+  m_free->push(nullptr);
+  m_thread.join();
+
+  for (auto &block : m_blocks) {
+    release(&block);
+  }
+
+  m_reading = false;
+  m_current = nullptr;
+  m_free.reset();
+  m_full.reset();
+}
+
+void Read_ahead_file::read_ahead() {
+  while (!m_stop) {
+    const auto block = m_free->pop();
+
+    if (!block || !reserve(block)) {
+      break;
+    }
+
+    block->offset = 0;
+    block->exception = nullptr;
+
+    try {
+      block->size = m_file->read(block->data.get(), m_block_size);
+    } catch (...) {
+      block->size = -1;
+      block->exception = std::current_exception();
+    }
+
+    ++m_ready;
+    m_full->push(block);
+
+    if (block->size <= 0) {
+      break;
+    }
+  }
+}
+
+bool Read_ahead_file::reserve(Block *block) {
+  if (m_budget) {
+    // memory is reserved only while the consumer has something to read, so
+    // that it always makes progress, even if other readers use the whole
+    // budget
+    while (m_ready > 0) {
+      if (m_stop) {
+        return false;
+      }
+
+      if (m_budget->acquire(m_block_size, k_budget_wait)) {
+        block->reserved = m_block_size;
+        break;
+      }
+    }
+
+    if (m_stop) {
+      return false;
+    }
+  }
+
+  // buffers are allocated only when they're needed, data is going to be
+  // overwritten, there's no need to initialize it
+  if (!block->data) {
+    block->data.reset(new char[m_block_size]);
+  }
+
+  return true;
+}
+
+void Read_ahead_file::release(Block *block) {
+  if (!m_budget) {
+    // there's no limit, buffer is reused
+    return;
+  }
+
+  // buffer is freed, so that memory not covered by the budget is not held
+  block->data.reset();
+
+  if (block->reserved > 0) {
+    m_budget->release(block->reserved);
+    block->reserved = 0;
+  }
+}
+
+}  // namespace storage
+}  // namespace mysqlshdk
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MYSQLSHDK_LIBS_STORAGE_READ_AHEAD_FILE_H_
+#define MYSQLSHDK_LIBS_STORAGE_READ_AHEAD_FILE_H_
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mysqlshdk/libs/storage/ifile.h"
+#include "mysqlshdk/libs/utils/memory_budget.h"
+#include "mysqlshdk/libs/utils/synchronized_queue.h"
+
+namespace mysqlshdk {
+namespace storage {
+
+/**
+ * Wraps a file which is read sequentially, data is read (i.e. downloaded
+ * and/or decompressed) ahead of the consumer by a helper thread, into a
+ * fixed number of blocks which are reused once consumed.
+ *
+ * The helper thread is started by the first read(), seek() restarts it.
+ *
+ * If memory budget is given, helper thread reserves memory for each block it
+ * reads while consumer has data which was read and not yet consumed, blocks
+ * which do not fit in the budget are not read until consumer catches up.
+ * Memory of a block is then allocated when the block is read and freed once
+ * it's consumed.
+ */
+class Read_ahead_file : public IFile {
+ public:
+  Read_ahead_file() = delete;
+
+  /**
+   * Creates the wrapper.
+   *
+   * @param file file to be read
+   * @param buffer_size number of bytes which are read ahead
+   * @param budget memory shared with other readers, optional
+   */
+  Read_ahead_file(std::unique_ptr<IFile> file, size_t buffer_size,
+                  utils::Memory_budget *budget = nullptr);
+
+  Read_ahead_file(const Read_ahead_file &other) = delete;
+  Read_ahead_file(Read_ahead_file &&other) = delete;
+
+  Read_ahead_file &operator=(const Read_ahead_file &other) = delete;
+  Read_ahead_file &operator=(Read_ahead_file &&other) = delete;
+
+  ~Read_ahead_file() override;
+
+  void open(Mode m) override;
+  bool is_open() const override;
+  int error() const override;
+  void close() override;
+
+  size_t file_size() const override;
+  std::string full_path() const override;
+  std::string filename() const override;
+  bool exists() const override;
+
+  off64_t seek(off64_t offset) override;
+  off64_t tell() const override;
+  ssize_t read(void *buffer, size_t length) override;
+  ssize_t write(const void *buffer, size_t length) override;
+  bool flush() override;
+
+  void rename(const std::string &new_name) override;
+  void remove() override;
+
+  IFile *file() const { return m_file.get(); }
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    // number of bytes read, 0 on EOF, -1 on error
+    ssize_t size = 0;
+    // number of bytes already consumed
+    size_t offset = 0;
+    // number of bytes reserved in the memory budget
+    size_t reserved = 0;
+    std::exception_ptr exception;
+  };
+
+  void start();
+
+  void stop();
+
+  void read_ahead();
+
+  bool reserve(Block *block);
+
+  void release(Block *block);
+
+  std::unique_ptr<IFile> m_file;
+  size_t m_block_size;
+  utils::Memory_budget *m_budget;
+  std::vector<Block> m_blocks;
+  std::unique_ptr<shcore::Synchronized_queue<Block *>> m_free;
+  std::unique_ptr<shcore::Synchronized_queue<Block *>> m_full;
+  Block *m_current = nullptr;
+  std::thread m_thread;
+  std::atomic<bool> m_stop{false};
+  // number of blocks which were read and not yet taken by the consumer
+  std::atomic<size_t> m_ready{0};
+  bool m_reading = false;
+  off64_t m_offset = 0;
+};
+
+}  // namespace storage
+}  // namespace mysqlshdk
+
+#endif  // MYSQLSHDK_LIBS_STORAGE_READ_AHEAD_FILE_H_
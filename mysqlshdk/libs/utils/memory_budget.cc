@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/libs/utils/memory_budget.h"
+
+#include <cassert>
+
+namespace mysqlshdk {
+namespace utils {
+
+size_t Memory_budget::used() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_used;
+}
+
+bool Memory_budget::acquire(size_t bytes, std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  if (!m_released.wait_for(lock, timeout,
+                           [this, bytes]() { return available(bytes); })) {
+    return false;
+  }
+
+  m_used += bytes;
+  return true;
+}
+
+void Memory_budget::release(size_t bytes) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    assert(m_used >= bytes);
+    m_used -= bytes;
+  }
+
+  m_released.notify_all();
+}
+
+bool Memory_budget::available(size_t bytes) const {
+  return 0 == m_used || m_used + bytes <= m_limit;
+}
+
+}  // namespace utils
+}  // namespace mysqlshdk
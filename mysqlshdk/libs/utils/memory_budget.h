@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MYSQLSHDK_LIBS_UTILS_MEMORY_BUDGET_H_
+#define MYSQLSHDK_LIBS_UTILS_MEMORY_BUDGET_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace mysqlshdk {
+namespace utils {
+
+/**
+ * Limits the amount of memory used by multiple threads, i.e. to buffer data
+ * which is read ahead of its consumers.
+ */
+class Memory_budget final {
+ public:
+  Memory_budget() = delete;
+
+  /**
+   * Creates the budget.
+   *
+   * @param limit maximum number of bytes which can be reserved at once
+   */
+  explicit Memory_budget(size_t limit) : m_limit(limit) {}
+
+  Memory_budget(const Memory_budget &other) = delete;
+  Memory_budget(Memory_budget &&other) = delete;
+
+  Memory_budget &operator=(const Memory_budget &other) = delete;
+  Memory_budget &operator=(Memory_budget &&other) = delete;
+
+  ~Memory_budget() = default;
+
+  size_t limit() const { return m_limit; }
+
+  size_t used() const;
+
+  /**
+   * Reserves the given number of bytes, waits for them to become available.
+   * Request which exceeds the limit is granted only if nothing else is
+   * reserved.
+   *
+   * @param bytes number of bytes to reserve
+   * @param timeout maximum time to wait
+   *
+   * @returns true if bytes were reserved, false on timeout
+   */
+  bool acquire(size_t bytes, std::chrono::milliseconds timeout);
+
+  /**
+   * Returns the bytes reserved by acquire().
+   */
+  void release(size_t bytes);
+
+ private:
+  bool available(size_t bytes) const;
+
+  const size_t m_limit;
+  size_t m_used = 0;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_released;
+};
+
+}  // namespace utils
+}  // namespace mysqlshdk
+
+#endif  // MYSQLSHDK_LIBS_UTILS_MEMORY_BUDGET_H_
@@ -39,6 +39,8 @@ namespace shcore {
 
 void Buffered_input::open(const std::string &filepath_) {
   close();
+  m_data = nullptr;
+  m_data_size = 0;
 #ifdef _WIN32
   m_fd = ::_open(filepath_.c_str(), O_RDONLY);
 #else
@@ -51,6 +53,13 @@ void Buffered_input::open(const std::string &filepath_) {
   }
 }
 
+void Buffered_input::open(const char *data, size_t size) {
+  close();
+  m_fd = -1;
+  m_data = data;
+  m_data_size = size;
+}
+
 void Buffered_input::close() {
   if (m_fd > 0) {
 #ifdef _WIN32
@@ -90,17 +99,27 @@ void Buffered_input::fill_buffer() {
   }
 
   m_pos = m_buffer;
+
+  if (m_data) {
+    const size_t bytes =
+        m_data_size < BUFFER_SIZE ? m_data_size : BUFFER_SIZE;
+    memcpy(m_buffer, m_data, bytes);
+    m_data += bytes;
+    m_data_size -= bytes;
+    m_end = m_buffer + bytes;
+  } else {
 #ifdef _WIN32
-  int bytes = ::_read(m_fd, m_buffer, BUFFER_SIZE);
+    int bytes = ::_read(m_fd, m_buffer, BUFFER_SIZE);
 #else
-  ssize_t bytes = ::read(m_fd, m_buffer, BUFFER_SIZE);
+    ssize_t bytes = ::read(m_fd, m_buffer, BUFFER_SIZE);
 #endif
 
-  if (bytes < 0) {
-    bytes = 0;
-  }
+    if (bytes < 0) {
+      bytes = 0;
+    }
 
-  m_end = m_buffer + bytes;
+    m_end = m_buffer + bytes;
+  }
 
   if (m_pos == m_end) {
     m_eof = true;
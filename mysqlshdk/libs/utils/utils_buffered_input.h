@@ -51,6 +51,14 @@ class Buffered_input {
 
   void open(const std::string &filepath_);
 
+  /**
+   * Reads the data from memory instead of a file.
+   *
+   * @param data Data to read, needs to be valid until input is closed.
+   * @param size Size of the data.
+   */
+  void open(const char *data, size_t size);
+
   bool eof() { return m_eof; }
 
   byte peek() {
@@ -88,6 +96,8 @@ class Buffered_input {
 
   static constexpr const size_t BUFFER_SIZE = 1 << 16;
   int m_fd = 0;
+  const char *m_data = nullptr;  //< Data read from memory
+  size_t m_data_size = 0;        //< Size of data which is left to be read
   bool m_eof = false;
   byte m_buffer[BUFFER_SIZE];
   byte *m_pos = m_buffer;
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MYSQLSHDK_LIBS_UTILS_WORK_STEALING_QUEUE_H_
+#define MYSQLSHDK_LIBS_UTILS_WORK_STEALING_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace shcore {
+
+/**
+ * Multiple producer, multiple consumer synchronized queue with a separate
+ * queue for each consumer. Tasks pushed by a consumer are stored in its own
+ * queue, consumers take tasks from their own queues and steal tasks from
+ * queues of other consumers only when their own queue is empty, or when
+ * another queue holds a task with a higher precedence.
+ *
+ * Tasks are ordered by priority, then by weight (heavier tasks first), and
+ * then, within a single queue, in the FIFO order.
+ */
+template <class T>
+class Work_stealing_queue final {
+ public:
+  enum class Priority { LOW, MEDIUM, HIGH };
+
+  static constexpr std::size_t k_any_worker =
+      std::numeric_limits<std::size_t>::max();
+
+  Work_stealing_queue() = delete;
+
+  /**
+   * Creates the queue.
+   *
+   * @param workers number of consumer threads.
+   */
+  explicit Work_stealing_queue(std::size_t workers) {
+    workers = std::max(workers, static_cast<std::size_t>(1));
+
+    for (std::size_t i = 0; i < workers; ++i) {
+      m_queues.emplace_back(std::make_unique<Worker_queue>());
+    }
+  }
+
+  Work_stealing_queue(const Work_stealing_queue &other) = delete;
+  Work_stealing_queue(Work_stealing_queue &&other) = delete;
+
+  Work_stealing_queue &operator=(const Work_stealing_queue &other) = delete;
+  Work_stealing_queue &operator=(Work_stealing_queue &&other) = delete;
+
+  ~Work_stealing_queue() = default;
+
+  /**
+   * Adds a task to the queue.
+   *
+   * @param task task to be added
+   * @param priority priority of the task
+   * @param weight tasks with the same priority are ordered by weight, heavier
+   *        tasks are returned first
+   * @param worker consumer which owns the task, if not given, tasks are
+   *        distributed evenly between consumers
+   */
+  void push(T &&task, Priority priority = Priority::MEDIUM,
+            uint64_t weight = 0, std::size_t worker = k_any_worker) {
+    if (k_any_worker == worker) {
+      worker = m_next_queue++;
+    }
+
+    auto &queue = *m_queues[worker % m_queues.size()];
+
+    // size is increased first, so that it's never lower than the number of
+    // tasks which can be taken
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      ++m_size;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.emplace_back(
+          Entry{std::move(task), {priority, weight, m_sequence++}});
+      std::push_heap(queue.tasks.begin(), queue.tasks.end(), Compare());
+      queue.update_top();
+    }
+
+    m_task_ready.notify_one();
+  }
+
+  /**
+   * Removes the task with the highest precedence from the queue of the given
+   * consumer, or steals one from another queue, waits if there are no tasks.
+   *
+   * @param worker consumer which requests a task
+   *
+   * @returns the task, or a default-constructed object if queue was shut down
+   *          and there are no more tasks
+   */
+  T pop(std::size_t worker) {
+    while (true) {
+      T task;
+
+      if (try_pop(worker, &task)) {
+        return task;
+      }
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_task_ready.wait(lock, [this]() { return m_size > 0 || m_shutdown; });
+
+      if (0 == m_size) {
+        return T();
+      }
+    }
+  }
+
+  /**
+   * Signals to consumer threads to complete operation once all tasks are
+   * processed.
+   */
+  void shutdown() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_shutdown = true;
+    }
+
+    m_task_ready.notify_all();
+  }
+
+  std::size_t size() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+  }
+
+ private:
+  struct Key {
+    Priority priority = Priority::LOW;
+    uint64_t weight = 0;
+    uint64_t sequence = 0;
+  };
+
+  struct Entry {
+    T task;
+    Key key;
+  };
+
+  struct Compare {
+    // true if a has lower precedence than b
+    bool operator()(const Key &a, const Key &b) const {
+      if (a.priority != b.priority) {
+        return a.priority < b.priority;
+      }
+
+      if (a.weight != b.weight) {
+        return a.weight < b.weight;
+      }
+
+      return a.sequence > b.sequence;
+    }
+
+    bool operator()(const Entry &a, const Entry &b) const {
+      return (*this)(a.key, b.key);
+    }
+  };
+
+  static constexpr uint64_t k_empty = 0;
+
+  // priority and weight packed into a single value, higher value has higher
+  // precedence
+  static uint64_t precedence(const Key &key) {
+    constexpr int k_weight_bits = 62;
+    constexpr uint64_t k_max_weight = (UINT64_C(1) << k_weight_bits) - 1;
+
+    return (static_cast<uint64_t>(key.priority) + 1) << k_weight_bits |
+           std::min(key.weight, k_max_weight);
+  }
+
+  struct Worker_queue {
+    // needs to be called with the mutex locked
+    void update_top() {
+      top = tasks.empty() ? k_empty : precedence(tasks.front().key);
+    }
+
+    std::mutex mutex;
+    // heap, task with the highest precedence is at the front
+    std::vector<Entry> tasks;
+    // precedence of the front task, allows to choose the queue without
+    // locking
+    std::atomic<uint64_t> top{k_empty};
+  };
+
+  bool try_pop(std::size_t worker, T *task) {
+    const auto count = m_queues.size();
+    auto victim = worker % count;
+    uint64_t victim_top = m_queues[victim]->top;
+
+    // own queue is used, unless it's empty or another queue holds a task with
+    // a higher priority, or with the same priority and a higher weight
+    for (std::size_t i = 1; i < count; ++i) {
+      const auto idx = (worker + i) % count;
+      const uint64_t top = m_queues[idx]->top;
+
+      if (top > victim_top) {
+        victim = idx;
+        victim_top = top;
+      }
+    }
+
+    if (k_empty == victim_top) {
+      return false;
+    }
+
+    {
+      auto &queue = *m_queues[victim];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+
+      // task could have been taken by another consumer in the meantime
+      if (queue.tasks.empty()) {
+        return false;
+      }
+
+      std::pop_heap(queue.tasks.begin(), queue.tasks.end(), Compare());
+      *task = std::move(queue.tasks.back().task);
+      queue.tasks.pop_back();
+      queue.update_top();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      --m_size;
+    }
+
+    return true;
+  }
+
+  std::vector<std::unique_ptr<Worker_queue>> m_queues;
+  std::atomic<std::size_t> m_next_queue{0};
+  std::atomic<uint64_t> m_sequence{0};
+  std::mutex m_mutex;
+  std::condition_variable m_task_ready;
+  std::size_t m_size = 0;
+  bool m_shutdown = false;
+};
+
+}  // namespace shcore
+
+#endif  // MYSQLSHDK_LIBS_UTILS_WORK_STEALING_QUEUE_H_
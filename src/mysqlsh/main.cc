@@ -328,10 +328,14 @@ int execute_import_command(mysqlsh::Command_line_shell *shell,
     for (auto &option : import_opts)
       shcore::Shell_cli_operation::add_option(options, option);
 
+    int64_t threads = 1;
+
     shcore::Option_unpacker unpacker(options);
+    unpacker.optional("threads", &threads);
     mysqlsh::unpack_json_import_flags(&unpacker, &roptions);
     unpacker.end();
 
+    importer.set_threads(threads);
     importer.load_from(roptions);
   } catch (...) {
     importer.print_stats();
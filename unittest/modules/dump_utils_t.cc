@@ -27,6 +27,7 @@
 #include "unittest/gtest_clean.h"
 
 #include "modules/util/load/dump_reader.h"
+#include "mysqlshdk/libs/utils/utils_net.h"
 
 namespace mysqlsh {
 namespace dump {
@@ -314,6 +315,12 @@ class Dump_scheduler : public ::testing::Test {
 };
 
 TEST_F(Dump_scheduler, load_scheduler) {
+  const auto schedule =
+      [](const std::unordered_multimap<std::string, size_t> &being_loaded,
+         std::unordered_set<Dump_reader::Table_info *> *with_data) {
+        return Dump_reader::schedule_chunk_by_size(being_loaded, with_data, 0,
+                                                   false);
+      };
   std::vector<Dump_reader::Table_info> tables;
   tables.push_back(make_table("mytable-1", 100, 20, 5));
 
@@ -321,13 +328,13 @@ TEST_F(Dump_scheduler, load_scheduler) {
   // just 1 thread
   {
     SCOPED_TRACE("1-1");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 1);
+    test_scheduling(schedule, tables, 1);
   }
 
   // fewer threads than tables
   {
     SCOPED_TRACE("1-3");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 3);
+    test_scheduling(schedule, tables, 3);
   }
 
   // 2 tables
@@ -336,13 +343,13 @@ TEST_F(Dump_scheduler, load_scheduler) {
   // just 1 thread
   {
     SCOPED_TRACE("2-1");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 1);
+    test_scheduling(schedule, tables, 1);
   }
 
   // fewer threads than tables
   {
     SCOPED_TRACE("2-4");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 4);
+    test_scheduling(schedule, tables, 4);
   }
 
   // 5 tables
@@ -353,25 +360,172 @@ TEST_F(Dump_scheduler, load_scheduler) {
   // just 1 thread
   {
     SCOPED_TRACE("1");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 1);
+    test_scheduling(schedule, tables, 1);
   }
 
   // fewer threads than tables
   {
     SCOPED_TRACE("3");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 3);
+    test_scheduling(schedule, tables, 3);
   }
 
   // same as tables
   {
     SCOPED_TRACE("5");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 5);
+    test_scheduling(schedule, tables, 5);
   }
 
   // more than tables
   {
     SCOPED_TRACE("16");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 16);
+    test_scheduling(schedule, tables, 16);
   }
 }
+
+TEST_F(Dump_scheduler, schedule_by_size) {
+  std::vector<Dump_reader::Table_info> tables;
+  tables.push_back(make_table("small", 2, 10, 1));
+  tables.push_back(make_table("big", 10, 100, 1));
+  tables.push_back(make_table("medium", 5, 50, 1));
+
+  std::unordered_set<Dump_reader::Table_info *> tables_with_data;
+
+  for (auto &t : tables) {
+    tables_with_data.insert(&t);
+  }
+
+  std::unordered_multimap<std::string, size_t> tables_being_loaded;
+
+  const auto next = [&](size_t max_threads) {
+    const auto it = Dump_reader::schedule_chunk_by_size(
+        tables_being_loaded, &tables_with_data, max_threads, false);
+
+    if (tables_with_data.end() == it) return std::string();
+
+    tables_being_loaded.emplace(schema_table_key((*it)->schema, (*it)->table),
+                                (*it)->available_chunk_sizes[0]);
+    return (*it)->table;
+  };
+
+  // tables which are not being loaded are picked first, biggest first
+  EXPECT_EQ("big", next(2));
+  EXPECT_EQ("medium", next(2));
+  EXPECT_EQ("small", next(2));
+
+  // then the most remaining data per thread
+  EXPECT_EQ("big", next(2));
+  EXPECT_EQ("medium", next(2));
+
+  // all tables are loaded by the maximum number of threads, apart from the
+  // small one
+  EXPECT_EQ("small", next(2));
+  EXPECT_EQ("", next(2));
+
+  // no limit
+  EXPECT_EQ("big", next(0));
+}
+
+TEST_F(Dump_scheduler, schedule_by_size_in_key_order) {
+  std::vector<Dump_reader::Table_info> tables;
+  tables.push_back(make_table("small", 2, 10, 1));
+  tables.push_back(make_table("big", 10, 100, 1));
+  tables.push_back(make_table("medium", 5, 50, 1));
+
+  // big table was chunked using its primary key
+  tables[1].primary_index = "id";
+
+  std::unordered_set<Dump_reader::Table_info *> tables_with_data;
+
+  for (auto &t : tables) {
+    tables_with_data.insert(&t);
+  }
+
+  std::unordered_multimap<std::string, size_t> tables_being_loaded;
+
+  const auto next = [&](bool prefer_key_order) {
+    const auto it = Dump_reader::schedule_chunk_by_size(
+        tables_being_loaded, &tables_with_data, 0, prefer_key_order);
+
+    if (tables_with_data.end() == it) return std::string();
+
+    tables_being_loaded.emplace(schema_table_key((*it)->schema, (*it)->table),
+                                (*it)->available_chunk_sizes[0]);
+    return (*it)->table;
+  };
+
+  // tables which are not being loaded are picked first, biggest first
+  EXPECT_EQ("big", next(true));
+  EXPECT_EQ("medium", next(true));
+  EXPECT_EQ("small", next(true));
+
+  // big table is not shared while other tables can be loaded
+  EXPECT_EQ("medium", next(true));
+  EXPECT_EQ("medium", next(true));
+
+  // key order is not preferred
+  EXPECT_EQ("big", next(false));
+
+  tables_being_loaded.clear();
+  tables_with_data.clear();
+  tables_with_data.insert(&tables[1]);
+  tables_with_data.insert(&tables[2]);
+  tables[2].primary_index = "id";
+
+  EXPECT_EQ("big", next(true));
+  EXPECT_EQ("medium", next(true));
+
+  // only tables chunked by the primary key are left, they are shared
+  EXPECT_EQ("big", next(true));
+
+  tables_with_data.erase(&tables[1]);
+  tables_with_data.erase(&tables[2]);
+  tables[0].chunked = false;
+  tables[0].primary_index = "id";
+  tables_with_data.insert(&tables[0]);
+  tables_being_loaded.emplace(schema_table_key("myschema", "small"), 10);
+
+  // non-chunked table is not affected
+  EXPECT_EQ("small", next(true));
+}
+
+TEST(Dump_reader, split_by_index) {
+  const auto make_index = [](const std::vector<uint64_t> &offsets) {
+    std::string index;
+
+    for (const auto offset : offsets) {
+      const auto value = mysqlshdk::utils::host_to_network(offset);
+      index.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    return index;
+  };
+  const auto split = [&make_index](const std::vector<uint64_t> &offsets,
+                                   size_t size, size_t range_size) {
+    std::string result;
+
+    for (const auto &range : Dump_reader::split_by_index(
+             make_index(offsets), size, range_size)) {
+      result += "[" + std::to_string(range.begin) + "," +
+                std::to_string(range.end) + ")";
+    }
+
+    return result;
+  };
+  const std::vector<uint64_t> offsets = {100, 200, 300, 400, 500,
+                                         600, 700, 800, 900, 1000};
+
+  EXPECT_EQ("[0,300)[300,600)[600,1000)", split(offsets, 1000, 300));
+  EXPECT_EQ("[0,400)[400,800)[800,1000)", split(offsets, 1000, 400));
+  EXPECT_EQ("[0,500)[500,1000)", split(offsets, 1000, 500));
+
+  // single range
+  EXPECT_EQ("", split(offsets, 1000, 1000));
+  // empty index
+  EXPECT_EQ("", split({}, 1000, 300));
+  // index is not complete
+  EXPECT_EQ("", split({100, 200, 300, 400}, 1000, 100));
+  // corrupted index
+  EXPECT_EQ("", split({300, 200, 1000}, 1000, 100));
+}
+
 }  // namespace mysqlsh
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "unittest/gtest_clean.h"
+
+#include "modules/util/dump/default_dump_writer.h"
+#include "modules/util/dump/text_dump_writer.h"
+#include "mysqlshdk/libs/db/row_copy.h"
+#include "mysqlshdk/libs/storage/backend/memory_file.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+
+namespace mysqlsh {
+namespace dump {
+
+namespace {
+
+using mysqlshdk::db::Column;
+using mysqlshdk::db::Mutable_row;
+using mysqlshdk::db::Type;
+
+Column column(const std::string &name, Type type) {
+  return Column("", "schema", "table", "table", name, name, 0, 0, type, 63,
+                false, false, false);
+}
+
+std::string write_row(Dump_writer *writer, const std::string &value) {
+  const std::vector<Column> metadata = {column("value", Type::String)};
+  Mutable_row row{{Type::String}, value};
+
+  auto memory = static_cast<mysqlshdk::storage::backend::Memory_file *>(
+      writer->output());
+
+  writer->open();
+  writer->write_preamble(metadata);
+  writer->write_row(&row);
+  writer->write_postamble();
+
+  const auto content = memory->content();
+
+  writer->close();
+
+  return content;
+}
+
+}  // namespace
+
+TEST(Dump_writer, block_buffering) {
+  const std::vector<Column> metadata = {column("id", Type::Integer),
+                                        column("name", Type::String)};
+  const std::vector<Type> types = {Type::Integer, Type::String};
+
+  auto file =
+      std::make_unique<mysqlshdk::storage::backend::Memory_file>("test.tsv");
+  const auto memory = file.get();
+
+  Default_dump_writer writer{std::move(file)};
+  writer.set_block_size(64);
+  writer.open();
+
+  Dump_write_result total;
+  std::string expected;
+
+  total += writer.write_preamble(metadata);
+  EXPECT_EQ(0u, total.data_bytes());
+  EXPECT_EQ(0u, total.bytes_written());
+
+  for (int i = 0; i < 20; ++i) {
+    Mutable_row row{types, i, "a\tb"};
+    expected += std::to_string(i) + "\ta\\tb\n";
+
+    const auto result = writer.write_row(&row);
+    total += result;
+
+    // data bytes are always exact, as they are used to write the index file
+    EXPECT_EQ(expected.length(), total.data_bytes());
+    // data is written in blocks
+    EXPECT_EQ(memory->content().length(), total.bytes_written());
+    EXPECT_GT(64u, expected.length() - memory->content().length());
+
+    if (result.bytes_written() > 0) {
+      EXPECT_LE(64u, result.bytes_written());
+    }
+  }
+
+  EXPECT_NE(expected, memory->content());
+
+  total += writer.write_postamble();
+
+  EXPECT_EQ(expected, memory->content());
+  EXPECT_EQ(expected.length(), total.data_bytes());
+  EXPECT_EQ(expected.length(), total.bytes_written());
+
+  writer.close();
+}
+
+TEST(Dump_writer, escaping) {
+  const std::string clean = "long run of characters which are not escaped";
+  const std::string value =
+      clean + std::string("a\0b\bc\nd\re\tf\x1Ag\\h\"i,j", 19) + clean;
+  const std::string escaped =
+      clean + "a\\0b\\bc\\nd\\re\\tf\\Zg\\\\h\"i,j" + clean;
+  const auto make_file = []() {
+    return std::make_unique<mysqlshdk::storage::backend::Memory_file>("file");
+  };
+
+  {
+    Default_dump_writer writer{make_file()};
+    EXPECT_EQ(escaped + "\n", write_row(&writer, value));
+  }
+
+  {
+    Default_dump_writer writer{make_file()};
+    EXPECT_EQ(clean + "\n", write_row(&writer, clean));
+  }
+
+  {
+    Text_dump_writer writer{make_file(), import_table::Dialect::csv()};
+    EXPECT_EQ("\"" + shcore::str_replace(escaped, "\"", "\\\"") + "\"\r\n",
+              write_row(&writer, value));
+  }
+
+  {
+    auto dialect = import_table::Dialect::csv();
+    dialect.fields_escaped_by = "";
+    Text_dump_writer writer{make_file(), dialect};
+    EXPECT_EQ("\"" + value + "\"\r\n", write_row(&writer, value));
+  }
+}
+
+TEST(Dump_writer, raw_row) {
+  const std::vector<Column> metadata = {column("id", Type::Integer),
+                                        column("value", Type::Double),
+                                        column("name", Type::String)};
+  // values of the second field are stored as strings, as the server sends them
+  const std::vector<Type> types = {Type::Integer, Type::String, Type::String};
+  const auto dump = [&metadata, &types](Dump_writer *writer, bool raw) {
+    auto memory = static_cast<mysqlshdk::storage::backend::Memory_file *>(
+        writer->output());
+
+    writer->open();
+    writer->write_preamble(metadata);
+
+    for (const auto &value : {"1.5", "-inf", "nan", ""}) {
+      const std::string name = std::string{"a\t,\""} + value;
+
+      if (raw) {
+        const char *data[] = {"7", value, name.c_str()};
+        const unsigned long lengths[] = {1, std::strlen(value), name.length()};
+        writer->write_row(data, lengths);
+      } else {
+        Mutable_row row{types, 7, std::string{value}, name};
+        writer->write_row(&row);
+      }
+    }
+
+    {
+      const char *data[] = {nullptr, nullptr, nullptr};
+      const unsigned long lengths[] = {0, 0, 0};
+
+      if (raw) {
+        writer->write_row(data, lengths);
+      } else {
+        Mutable_row row{types, nullptr, nullptr, nullptr};
+        writer->write_row(&row);
+      }
+    }
+
+    writer->write_postamble();
+
+    const auto content = memory->content();
+
+    writer->close();
+
+    return content;
+  };
+  const auto make_file = []() {
+    return std::make_unique<mysqlshdk::storage::backend::Memory_file>("file");
+  };
+
+  {
+    Default_dump_writer row_writer{make_file()};
+    Default_dump_writer raw_writer{make_file()};
+    const auto expected = dump(&row_writer, false);
+
+    EXPECT_EQ(expected, dump(&raw_writer, true));
+    EXPECT_NE(std::string::npos, expected.find("\\N\t\\N\t\\N\n"));
+  }
+
+  {
+    Text_dump_writer row_writer{make_file(), import_table::Dialect::csv()};
+    Text_dump_writer raw_writer{make_file(), import_table::Dialect::csv()};
+
+    EXPECT_EQ(dump(&row_writer, false), dump(&raw_writer, true));
+  }
+}
+
+}  // namespace dump
+}  // namespace mysqlsh
@@ -19,16 +19,22 @@
  along with this program; if not, write to the Free Software Foundation, Inc.,
  51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA */
 
+#include <atomic>
 #include <iostream>
 #include <queue>
 #include <random>
+#include <string>
+#include <vector>
 
 #include "gtest_clean.h"
 
 #include "modules/util/import_table/chunk_file.h"
 #include "modules/util/import_table/import_table.h"
+#include "modules/util/import_table/load_data.h"
+#include "mysqlshdk/libs/storage/backend/memory_file.h"
 #include "mysqlshdk/libs/utils/synchronized_queue.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
 
 namespace mysqlsh {
 namespace import_table {
@@ -559,6 +565,70 @@ TEST(import_table, multichar_line_terminator_with_buffer_invalidation) {
   shcore::delete_file(path, true);
 }
 
+TEST(import_table, line_terminator_in_reserved_area) {
+  const std::string line_terminator{"\r\n"};
+  const std::string path{"import_table_line_terminator_in_reserved_area.dump"};
+
+  // first row ends in the area reserved at the end of the buffer, next rows
+  // are found in the following buffers
+  std::vector<Range> expected_ranges;
+  std::string test_string(kBufferSize - line_terminator.size() - 1, 'a');
+  test_string += line_terminator;
+  expected_ranges.push_back(Range{0, test_string.size()});
+
+  for (size_t i = 0; test_string.size() < 3 * kBufferSize; ++i) {
+    const auto begin = test_string.size();
+    test_string += std::string(2 + (i * 7919) % 300, 'b');
+    test_string += line_terminator;
+    expected_ranges.push_back(Range{begin, test_string.size()});
+  }
+
+  shcore::create_file(path, test_string, true);
+  const size_t needle_size = line_terminator.size();
+
+  {
+    auto fh_ptr = mysqlshdk::storage::make_file(path);
+    File_handler fh{fh_ptr.get()};
+    std::queue<Range> r;
+    chunk_by_max_bytes(fh.begin(needle_size), fh.end(needle_size),
+                       line_terminator, 1, &r);
+
+    EXPECT_EQ(expected_ranges.size(), r.size());
+
+    for (size_t i = 0; i < expected_ranges.size() && !r.empty(); i++) {
+      auto range = r.front();
+      r.pop();
+
+      EXPECT_EQ(expected_ranges[i].begin, range.begin);
+      EXPECT_EQ(expected_ranges[i].end, range.end);
+    }
+  }
+  {
+    auto fh_ptr = mysqlshdk::storage::make_file(path);
+    File_handler fh{fh_ptr.get()};
+    std::queue<Range> r;
+    auto row = fh.begin(needle_size);
+    auto last = fh.end(needle_size);
+    while (row != last) {
+      auto previous = row;
+      row = skip_rows(row, fh.end(needle_size), line_terminator, 1, '\\');
+      r.push(Range{previous.offset(), row.offset()});
+    }
+
+    EXPECT_EQ(expected_ranges.size(), r.size());
+
+    for (size_t i = 0; i < expected_ranges.size() && !r.empty(); i++) {
+      auto range = r.front();
+      r.pop();
+
+      EXPECT_EQ(expected_ranges[i].begin, range.begin);
+      EXPECT_EQ(expected_ranges[i].end, range.end);
+    }
+  }
+
+  shcore::delete_file(path, true);
+}
+
 TEST(import_table, false_line_terminator_after_eof) {
   const std::string line_terminator{"aaaabbbbbbbb"};
   const std::string path{"false_line_terminator_after_eof.dump"};
@@ -1031,5 +1101,178 @@ TEST(import_table, twochar_aa_line_terminator_same_as_row_data) {
   shcore::delete_file(path, true);
 }
 
+TEST(import_table, row_end_finder) {
+  {
+    Row_end_finder finder{"\n", "\\"};
+    size_t end = 0;
+
+    // escape state is unknown at the beginning
+    EXPECT_FALSE(finder.find("\n", 1, &end));
+
+    EXPECT_TRUE(finder.find("ab\ncd\n", 6, &end));
+    EXPECT_EQ(3, end);
+
+    // escaped terminator
+    EXPECT_FALSE(finder.find("ab\\\ncd", 6, &end));
+    EXPECT_TRUE(finder.find("\n", 1, &end));
+    EXPECT_EQ(1, end);
+
+    // escape character at the end of skipped data
+    finder.skip("xy\\", 3);
+    EXPECT_FALSE(finder.find("\n", 1, &end));
+  }
+
+  {
+    Row_end_finder finder{"\r\n", ""};
+    size_t end = 0;
+
+    finder.skip("abc", 3);
+    EXPECT_FALSE(finder.find("a\nb\r", 4, &end));
+    // terminator spans two buffers
+    EXPECT_TRUE(finder.find("\nc", 2, &end));
+    EXPECT_EQ(1, end);
+  }
+}
+
+TEST(import_table, load_data_split_into_transactions) {
+  std::string data;
+
+  for (int i = 0; i < 1000; ++i) {
+    data += "row\\\n" + std::to_string(i) + "\tvalue\n";
+  }
+
+  const std::string path{"import_table_transactions.tsv"};
+  shcore::create_file(path, data, true);
+
+  constexpr size_t max_transaction_size = 512;
+  std::atomic<size_t> prog_bytes{0};
+  volatile bool interrupt = false;
+
+  File_info fi;
+  fi.filehandler = mysqlshdk::storage::make_file(path);
+  fi.prog = nullptr;
+  fi.prog_bytes = &prog_bytes;
+  fi.user_interrupt = &interrupt;
+  fi.max_transaction_size = max_transaction_size;
+  fi.row_end = Row_end_finder{"\n", "\\"};
+
+  std::vector<std::string> statements;
+  char buffer[100];
+
+  // simulate the LOAD DATA statements executed by the worker
+  do {
+    void *userdata = nullptr;
+    ASSERT_EQ(0, local_infile_init(&userdata, path.c_str(), &fi));
+
+    std::string statement;
+    int bytes = 0;
+
+    while ((bytes = local_infile_read(userdata, buffer, sizeof(buffer))) > 0) {
+      statement.append(buffer, bytes);
+    }
+
+    ASSERT_EQ(0, bytes);
+    local_infile_end(userdata);
+
+    statements.emplace_back(std::move(statement));
+  } while (fi.continuation);
+
+  EXPECT_EQ(data, shcore::str_join(statements, ""));
+  EXPECT_EQ(data.size(), prog_bytes);
+  EXPECT_LT(1, statements.size());
+
+  for (size_t i = 0; i < statements.size(); ++i) {
+    const auto &s = statements[i];
+    SCOPED_TRACE(i);
+
+    if (i + 1 < statements.size()) {
+      EXPECT_LE(max_transaction_size, s.size());
+      EXPECT_GT(max_transaction_size + 20, s.size());
+    }
+
+    // each statement ends at the end of a row
+    ASSERT_LE(2, s.size());
+    EXPECT_EQ('\n', s[s.size() - 1]);
+    EXPECT_NE('\\', s[s.size() - 2]);
+  }
+
+  EXPECT_FALSE(fi.filehandler->is_open());
+
+  shcore::delete_file(path, true);
+}
+
+TEST(import_table, chunk_stream) {
+  std::string data;
+
+  for (int i = 0; i < 20000; ++i) {
+    data += "row\\\n" + std::to_string(i) + "\tvalue\n";
+  }
+
+  mysqlshdk::storage::backend::Memory_file file{"stream"};
+  file.set_content(data);
+
+  Dialect dialect;
+  dialect.lines_terminated_by = "\n";
+  dialect.fields_escaped_by = "\\";
+
+  constexpr size_t chunk_size = 2 * BUFFER_SIZE;
+  constexpr size_t rows_to_skip = 2;
+
+  Chunk_stream chunk;
+  chunk.set_chunk_size(chunk_size);
+  chunk.set_file_handle(&file);
+  chunk.set_dialect(dialect);
+  chunk.set_rows_to_skip(rows_to_skip);
+
+  std::vector<Data_block> blocks;
+
+  chunk.start([&blocks](Data_block &&block) {
+    blocks.emplace_back(std::move(block));
+    return true;
+  });
+
+  EXPECT_FALSE(file.is_open());
+  ASSERT_LT(1, blocks.size());
+
+  size_t skipped = 0;
+
+  for (size_t i = 0; i < rows_to_skip; ++i) {
+    skipped = data.find("value\n", skipped) + 6;
+  }
+
+  std::string loaded;
+  size_t offset = skipped;
+
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    const auto &b = blocks[i];
+    SCOPED_TRACE(i);
+
+    EXPECT_EQ(offset, b.begin);
+    offset += b.data.size();
+    EXPECT_EQ(offset, b.end);
+    loaded += b.data;
+
+    if (i + 1 < blocks.size()) {
+      EXPECT_LE(chunk_size, b.data.size());
+      EXPECT_GT(chunk_size + 20, b.data.size());
+    }
+
+    // each block ends at the end of a row
+    ASSERT_LE(2, b.data.size());
+    EXPECT_EQ('\n', b.data[b.data.size() - 1]);
+    EXPECT_NE('\\', b.data[b.data.size() - 2]);
+  }
+
+  EXPECT_EQ(data.substr(skipped), loaded);
+
+  // consumer stops reading
+  size_t count = 0;
+
+  chunk.start([&count](Data_block &&) { return ++count < 2; });
+
+  EXPECT_EQ(2, count);
+  EXPECT_FALSE(file.is_open());
+}
+
 }  // namespace import_table
 }  // namespace mysqlsh
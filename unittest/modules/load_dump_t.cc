@@ -113,4 +113,23 @@ TEST(Load_dump, sql_transforms_strip_sql_mode) {
             "sql_mode='ANSI_QUOTES,NO_AUTO_CREATE_USER,NO_ZERO_DATE' */"));
 }
 
+TEST(Load_dump, split_chunk_counted_once) {
+  Load_dump_options options{"dump"};
+  Dump_loader loader{options};
+  loader.m_load_log = std::make_unique<Load_progress_log>();
+
+  // chunk was split into three sub-chunks
+  auto &chunk = loader.m_split_chunks[schema_table_key("s", "t") + ":1"];
+  chunk.file = "s@t@1.tsv";
+  chunk.pending = 3;
+
+  loader.on_sub_chunk_load_end("s", "t", 1, {0, 10}, 10, 10);
+  loader.on_sub_chunk_load_end("s", "t", 1, {10, 20}, 10, 10);
+  EXPECT_EQ(0u, loader.m_num_chunks_loaded.load());
+
+  loader.on_sub_chunk_load_end("s", "t", 1, {20, 30}, 10, 10);
+  EXPECT_EQ(1u, loader.m_num_chunks_loaded.load());
+  EXPECT_TRUE(loader.m_split_chunks.empty());
+}
+
 }  // namespace mysqlsh
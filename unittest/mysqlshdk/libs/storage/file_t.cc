@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "unittest/gtest_clean.h"
+
+#include <random>
+#include <string>
+
+#include "mysqlshdk/libs/storage/backend/file.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+
+namespace mysqlshdk {
+namespace storage {
+namespace tests {
+
+class Storage_file_test : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    m_path = shcore::path::join_path(getenv("TMPDIR"), "storage_file_test");
+  }
+
+  void TearDown() override { shcore::delete_file(m_path); }
+
+  std::string m_path;
+};
+
+TEST_F(Storage_file_test, read) {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<> distribution{0, 255};
+  std::string data(3 * (1 << 20) + 17, '\0');
+
+  for (auto &c : data) {
+    c = static_cast<char>(distribution(generator));
+  }
+
+  shcore::create_file(m_path, data, true);
+
+  // file is read with and without mapping it into memory
+  for (const bool mapped : {false, true}) {
+    SCOPED_TRACE(mapped ? "mapped" : "not mapped");
+
+    backend::File file{m_path};
+    file.use_memory_mapping(mapped);
+    file.open(Mode::READ);
+    ASSERT_TRUE(file.is_open());
+    EXPECT_EQ(data.size(), file.file_size());
+
+    {
+      // read the whole file using buffers of various sizes
+      std::string result;
+      std::string buffer(70000, '\0');
+      size_t length = 1;
+      ssize_t bytes = 0;
+
+      while ((bytes = file.read(&buffer[0], length)) > 0) {
+        result.append(buffer, 0, bytes);
+        EXPECT_EQ(static_cast<off64_t>(result.size()), file.tell());
+        length = length * 7 % buffer.size() + 1;
+      }
+
+      EXPECT_EQ(0, bytes);
+      EXPECT_EQ(data, result);
+    }
+
+    {
+      // random access
+      std::string buffer(1000, '\0');
+
+      for (const size_t offset : {size_t{0}, size_t{4095}, size_t{1 << 20},
+                                  data.size() - 500}) {
+        ASSERT_NE(-1, file.seek(offset));
+        const auto bytes = file.read(&buffer[0], buffer.size());
+        const auto expected = std::min(buffer.size(), data.size() - offset);
+        ASSERT_EQ(static_cast<ssize_t>(expected), bytes);
+        EXPECT_EQ(data.substr(offset, expected), buffer.substr(0, bytes));
+      }
+
+      ASSERT_NE(-1, file.seek(data.size() + 10));
+      EXPECT_EQ(0, file.read(&buffer[0], buffer.size()));
+    }
+
+    file.close();
+    EXPECT_FALSE(file.is_open());
+  }
+}
+
+TEST_F(Storage_file_test, read_empty) {
+  shcore::create_file(m_path, "", true);
+
+  backend::File file{m_path};
+  file.use_memory_mapping(true);
+  file.open(Mode::READ);
+  ASSERT_TRUE(file.is_open());
+
+  char buffer[16];
+  EXPECT_EQ(0, file.read(buffer, sizeof(buffer)));
+
+  file.close();
+}
+
+}  // namespace tests
+}  // namespace storage
+}  // namespace mysqlshdk
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "unittest/gtest_clean.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mysqlshdk/libs/storage/backend/memory_directory.h"
+#include "mysqlshdk/libs/storage/idirectory.h"
+
+namespace mysqlshdk {
+namespace storage {
+namespace tests {
+
+namespace {
+
+void write_file(const IDirectory &dir, const std::string &name,
+                const std::string &content) {
+  const auto file = dir.file(name);
+  file->open(Mode::WRITE);
+  file->write(content.data(), content.length());
+  file->close();
+}
+
+std::string read_file(const IDirectory &dir, const std::string &name) {
+  const auto file = dir.file(name);
+  file->open(Mode::READ);
+  std::string content(file->file_size(), '\0');
+  EXPECT_EQ(static_cast<ssize_t>(content.length()),
+            file->read(&content[0], content.length()));
+  file->close();
+  return content;
+}
+
+}  // namespace
+
+TEST(Memory_directory_test, shared_contents) {
+  using backend::Memory_directory;
+
+  EXPECT_FALSE(make_directory("memory://test")->exists());
+
+  const auto contents = Memory_directory::register_contents("test", 1024);
+  EXPECT_THROW(Memory_directory::register_contents("test", 1024),
+               std::invalid_argument);
+
+  const auto writer = make_directory("memory://test");
+  const auto reader = make_directory("memory://test");
+  ASSERT_TRUE(writer->exists());
+  EXPECT_EQ("memory://test", writer->full_path());
+  EXPECT_TRUE(reader->list_files().empty());
+
+  // file is visible once it's closed
+  const auto file = writer->file("data.tsv.dumping");
+  file->open(Mode::WRITE);
+  file->write("abc", 3);
+  EXPECT_FALSE(reader->file("data.tsv.dumping")->exists());
+  file->close();
+  file->rename("data.tsv");
+
+  ASSERT_EQ(1, reader->list_files().size());
+  EXPECT_EQ("data.tsv", reader->list_files()[0].name);
+  EXPECT_EQ(3, reader->list_files()[0].size);
+  EXPECT_EQ("abc", read_file(*reader, "data.tsv"));
+
+  const auto seek = reader->file("data.tsv");
+  seek->open(Mode::READ);
+  EXPECT_EQ(1, seek->seek(1));
+  char c = 0;
+  EXPECT_EQ(1, seek->read(&c, 1));
+  EXPECT_EQ('b', c);
+  seek->close();
+
+  const auto append = writer->file("data.tsv");
+  append->open(Mode::APPEND);
+  append->write("def", 3);
+  append->close();
+  EXPECT_EQ("abcdef", read_file(*reader, "data.tsv"));
+
+  reader->file("data.tsv")->remove();
+  EXPECT_TRUE(writer->list_files().empty());
+  EXPECT_THROW(reader->file("data.tsv")->open(Mode::READ), std::runtime_error);
+
+  Memory_directory::unregister_contents("test");
+  EXPECT_FALSE(make_directory("memory://test")->exists());
+}
+
+TEST(Memory_directory_test, capacity) {
+  using backend::Memory_directory;
+
+  const auto contents = Memory_directory::register_contents("capacity", 4);
+  const auto dir = make_directory("memory://capacity");
+
+  // file larger than the capacity is stored in an empty directory
+  write_file(*dir, "first", "12345");
+
+  std::thread writer([&dir]() { write_file(*dir, "second", "12"); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(dir->file("second")->exists());
+
+  // space is released, writer is unblocked
+  dir->file("first")->remove();
+  writer.join();
+  EXPECT_EQ("12", read_file(*dir, "second"));
+
+  write_file(*dir, "third", "12");
+
+  // directory is full, shutdown releases all waiting threads
+  std::thread blocked([&dir]() {
+    EXPECT_THROW(write_file(*dir, "fourth", "1"), std::runtime_error);
+  });
+  std::thread waiter([&contents]() { EXPECT_FALSE(contents->wait_for("x")); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  contents->shutdown();
+  blocked.join();
+  waiter.join();
+
+  Memory_directory::unregister_contents("capacity");
+}
+
+TEST(Memory_directory_test, reserve_while_writing) {
+  using backend::Memory_directory;
+
+  const auto contents = Memory_directory::register_contents(
+      "reserve", 4,
+      [](const std::string &name) { return name.back() != 'n'; });
+  const auto dir = make_directory("memory://reserve");
+
+  // files which are not counted do not block the writers
+  write_file(*dir, "@.json", "1234567890");
+
+  // there are no counted files, capacity is exceeded by the file being written
+  write_file(*dir, "first", "12345");
+
+  std::atomic<bool> written{false};
+
+  // writer is blocked before the file is closed
+  std::thread writer([&dir, &written]() {
+    const auto file = dir->file("second");
+    file->open(Mode::WRITE);
+    file->write("1", 1);
+    written = true;
+    file->close();
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(written);
+
+  dir->file("first")->remove();
+  writer.join();
+  EXPECT_TRUE(written);
+  EXPECT_EQ("1", read_file(*dir, "second"));
+
+  {
+    // memory reserved by a file which was not closed is released
+    const auto file = dir->file("discarded");
+    file->open(Mode::WRITE);
+    file->write("12", 2);
+  }
+
+  std::thread third([&dir, &written]() {
+    written = false;
+    EXPECT_NO_THROW(write_file(*dir, "third", "123"));
+    written = true;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_TRUE(written);
+
+  if (!written) {
+    contents->shutdown();
+  }
+
+  third.join();
+  EXPECT_FALSE(dir->file("discarded")->exists());
+
+  Memory_directory::unregister_contents("reserve");
+}
+
+TEST(Memory_directory_test, filter_files) {
+  using backend::Memory_directory;
+
+  Memory_directory::register_contents("filter", 1024);
+  const auto dir = make_directory("memory://filter");
+
+  write_file(*dir, "s@t@0.tsv", "1");
+  write_file(*dir, "s@t@@1.tsv", "22");
+  write_file(*dir, "s@u@0.tsv", "333");
+  write_file(*dir, "@.done.json", "{}");
+
+  const auto names = [](const std::vector<IDirectory::File_info> &files) {
+    std::set<std::string> result;
+    for (const auto &f : files) result.emplace(f.name);
+    return result;
+  };
+
+  EXPECT_EQ((std::set<std::string>{"s@t@0.tsv", "s@t@@1.tsv", "@.done.json"}),
+            names(dir->filter_files({"s@t@", "@.done.json"})));
+  EXPECT_EQ((std::set<std::string>{"s@u@0.tsv"}),
+            names(dir->filter_files({"s@u"})));
+  EXPECT_TRUE(dir->filter_files({"x"}).empty());
+  EXPECT_TRUE(dir->filter_files({}).empty());
+
+  Memory_directory::unregister_contents("filter");
+}
+
+TEST(Memory_directory_test, wait_for_files) {
+  using backend::Memory_directory;
+
+  Memory_directory::register_contents("wait", 1024);
+  const auto writer_dir = make_directory("memory://wait");
+
+  write_file(*writer_dir, "before", "1");
+
+  Memory_directory dir{"wait"};
+
+  // files stored before the handle was created are not reported
+  EXPECT_FALSE(dir.wait_for_files(std::chrono::milliseconds(10)));
+
+  // file stored between the calls is reported immediately
+  write_file(*writer_dir, "between", "1");
+  EXPECT_TRUE(dir.wait_for_files(std::chrono::milliseconds(0)));
+  EXPECT_FALSE(dir.wait_for_files(std::chrono::milliseconds(10)));
+
+  std::thread writer([&writer_dir]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    write_file(*writer_dir, "after", "1");
+  });
+
+  // waiter is woken up by the writer well before the timeout
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(dir.wait_for_files(std::chrono::seconds(10)));
+  EXPECT_GT(std::chrono::seconds(5), std::chrono::steady_clock::now() - start);
+
+  writer.join();
+
+  Memory_directory::unregister_contents("wait");
+}
+
+}  // namespace tests
+}  // namespace storage
+}  // namespace mysqlshdk
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "unittest/gtest_clean.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "mysqlshdk/libs/storage/backend/memory_file.h"
+#include "mysqlshdk/libs/storage/read_ahead_file.h"
+
+namespace mysqlshdk {
+namespace storage {
+namespace tests {
+
+namespace {
+
+std::unique_ptr<IFile> make_file(const std::string &content) {
+  auto file = std::make_unique<backend::Memory_file>("file");
+  file->open(Mode::WRITE);
+  file->write(content.data(), content.length());
+  file->close();
+  return file;
+}
+
+std::string read_all(IFile *file, size_t length) {
+  std::string result;
+  std::string buffer(length, '\0');
+  ssize_t bytes = 0;
+
+  while ((bytes = file->read(&buffer[0], length)) > 0) {
+    result.append(buffer.data(), bytes);
+  }
+
+  EXPECT_EQ(0, bytes);
+
+  return result;
+}
+
+class Failing_file : public backend::Memory_file {
+ public:
+  Failing_file() : Memory_file("failing") {}
+
+  ssize_t read(void *, size_t) override {
+    throw std::runtime_error("read failed");
+  }
+};
+
+}  // namespace
+
+TEST(Read_ahead_file, read) {
+  std::string content;
+
+  for (int i = 0; i < 10000; ++i) {
+    content += std::to_string(i) + "\n";
+  }
+
+  for (const auto buffer_size : {1, 7, 1024, 1024 * 1024 * 4}) {
+    for (const auto read_size : {1, 13, 4096, 1024 * 1024}) {
+      SCOPED_TRACE(std::to_string(buffer_size) + ", " +
+                   std::to_string(read_size));
+
+      Read_ahead_file file{make_file(content),
+                           static_cast<size_t>(buffer_size)};
+      file.open(Mode::READ);
+
+      EXPECT_EQ(content, read_all(&file, read_size));
+      EXPECT_EQ(static_cast<off64_t>(content.length()), file.tell());
+      // EOF is reported again
+      char c;
+      EXPECT_EQ(0, file.read(&c, 1));
+
+      file.close();
+    }
+  }
+}
+
+TEST(Read_ahead_file, seek) {
+  const std::string content = "0123456789abcdefghijklmnopqrstuvwxyz";
+  Read_ahead_file file{make_file(content), 4};
+  char buffer[8];
+
+  file.open(Mode::READ);
+
+  EXPECT_EQ(5, file.read(buffer, 5));
+  EXPECT_EQ("01234", std::string(buffer, 5));
+
+  EXPECT_NE(-1, file.seek(20));
+  EXPECT_EQ(20, file.tell());
+  EXPECT_EQ(8, file.read(buffer, 8));
+  EXPECT_EQ("klmnopqr", std::string(buffer, 8));
+  EXPECT_EQ(28, file.tell());
+
+  EXPECT_NE(-1, file.seek(10));
+  EXPECT_EQ("abcdefghijklmnopqrstuvwxyz", read_all(&file, 3));
+
+  file.close();
+
+  // file can be read again after it's reopened
+  file.open(Mode::READ);
+  EXPECT_EQ(content, read_all(&file, 8));
+  file.close();
+}
+
+TEST(Read_ahead_file, error) {
+  Read_ahead_file file{std::make_unique<Failing_file>(), 1024};
+  char buffer[8];
+
+  file.open(Mode::READ);
+
+  EXPECT_THROW(file.read(buffer, 8), std::runtime_error);
+  EXPECT_THROW(file.read(buffer, 8), std::runtime_error);
+
+  file.close();
+}
+
+TEST(Read_ahead_file, memory_budget) {
+  std::string content;
+
+  for (int i = 0; i < 1000000; ++i) {
+    content += std::to_string(i) + "\n";
+  }
+
+  constexpr size_t k_block_size = 1024 * 1024;
+  utils::Memory_budget budget{k_block_size};
+
+  // each file reads ahead 4 blocks, budget allows for one more block to be
+  // buffered by both of them
+  Read_ahead_file first{make_file(content), 4 * k_block_size, &budget};
+  Read_ahead_file second{make_file(content), 4 * k_block_size, &budget};
+  std::string first_data;
+  std::string second_data;
+  std::string buffer(4096, '\0');
+  ssize_t bytes = 0;
+
+  first.open(Mode::READ);
+  second.open(Mode::READ);
+
+  do {
+    bytes = first.read(&buffer[0], buffer.length());
+    ASSERT_LE(0, bytes);
+    first_data.append(buffer.data(), bytes);
+
+    bytes = second.read(&buffer[0], buffer.length());
+    ASSERT_LE(0, bytes);
+    second_data.append(buffer.data(), bytes);
+
+    EXPECT_GE(budget.limit(), budget.used());
+  } while (bytes > 0);
+
+  EXPECT_EQ(content, first_data);
+  EXPECT_EQ(content, second_data);
+
+  first.close();
+  second.close();
+
+  // all memory is released
+  EXPECT_EQ(0, budget.used());
+}
+
+}  // namespace tests
+}  // namespace storage
+}  // namespace mysqlshdk
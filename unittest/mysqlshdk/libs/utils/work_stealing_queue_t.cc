@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2020, 2020, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest_clean.h"
+#include "mysqlshdk/libs/utils/work_stealing_queue.h"
+
+namespace shcore {
+
+using Queue = Work_stealing_queue<int>;
+
+TEST(Work_stealing_queue, order) {
+  Queue queue{1};
+
+  queue.push(1, Queue::Priority::LOW, 10);
+  queue.push(2, Queue::Priority::MEDIUM, 0);
+  queue.push(3, Queue::Priority::MEDIUM, 100);
+  queue.push(4, Queue::Priority::HIGH, 0);
+  queue.push(5, Queue::Priority::MEDIUM, 100);
+  queue.push(6, Queue::Priority::LOW, 20);
+
+  EXPECT_EQ(6u, queue.size());
+
+  // priority first, then weight, then FIFO
+  EXPECT_EQ(4, queue.pop(0));
+  EXPECT_EQ(3, queue.pop(0));
+  EXPECT_EQ(5, queue.pop(0));
+  EXPECT_EQ(2, queue.pop(0));
+  EXPECT_EQ(6, queue.pop(0));
+  EXPECT_EQ(1, queue.pop(0));
+
+  EXPECT_EQ(0u, queue.size());
+
+  queue.shutdown();
+
+  EXPECT_EQ(0, queue.pop(0));
+}
+
+TEST(Work_stealing_queue, steal) {
+  Queue queue{3};
+
+  queue.push(1, Queue::Priority::LOW, 0, 0);
+  queue.push(2, Queue::Priority::LOW, 0, 0);
+  queue.push(3, Queue::Priority::HIGH, 0, 2);
+  queue.push(4, Queue::Priority::LOW, 0, 1);
+
+  // task with a higher priority is taken from another queue
+  EXPECT_EQ(3, queue.pop(1));
+  // idle consumer steals from another queue
+  EXPECT_EQ(1, queue.pop(2));
+  // own queue is used first
+  EXPECT_EQ(4, queue.pop(1));
+  EXPECT_EQ(2, queue.pop(0));
+
+  queue.shutdown();
+
+  EXPECT_EQ(0, queue.pop(0));
+  EXPECT_EQ(0, queue.pop(1));
+  EXPECT_EQ(0, queue.pop(2));
+}
+
+TEST(Work_stealing_queue, own_queue_first) {
+  Queue queue{2};
+
+  queue.push(1, Queue::Priority::MEDIUM, 10, 0);
+  queue.push(2, Queue::Priority::MEDIUM, 100, 1);
+  queue.push(3, Queue::Priority::MEDIUM, 1000, 1);
+  queue.push(4, Queue::Priority::MEDIUM, 10, 1);
+
+  // heavier tasks of another queue with the same priority are stolen
+  EXPECT_EQ(3, queue.pop(0));
+  EXPECT_EQ(2, queue.pop(0));
+  // if priority and weight are the same, own queue is used first
+  EXPECT_EQ(4, queue.pop(1));
+  EXPECT_EQ(1, queue.pop(1));
+
+  queue.shutdown();
+}
+
+TEST(Work_stealing_queue, shutdown_processes_remaining_tasks) {
+  Queue queue{2};
+
+  // tasks are distributed between the queues
+  queue.push(1);
+  queue.push(2);
+  queue.shutdown();
+
+  EXPECT_EQ(2, queue.pop(1));
+  EXPECT_EQ(1, queue.pop(1));
+  EXPECT_EQ(0, queue.pop(1));
+  EXPECT_EQ(0, queue.pop(0));
+}
+
+TEST(Work_stealing_queue, multiple_threads) {
+  const std::size_t threads = 4;
+  const int tasks = 10000;
+  Queue queue{threads};
+  std::atomic<int> sum{0};
+  std::atomic<int> count{0};
+  std::vector<std::thread> workers;
+
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers.emplace_back([&queue, &sum, &count, i]() {
+      while (true) {
+        const auto task = queue.pop(i);
+
+        if (0 == task) {
+          break;
+        }
+
+        // consumers also produce tasks
+        if (task % 2 == 0) {
+          queue.push(-1, Queue::Priority::HIGH, 0, i);
+        }
+
+        sum += task;
+        ++count;
+      }
+    });
+  }
+
+  for (int i = 1; i <= tasks; ++i) {
+    queue.push(int{i}, Queue::Priority::MEDIUM, i % 7);
+  }
+
+  while (count < tasks + tasks / 2) {
+    std::this_thread::yield();
+  }
+
+  queue.shutdown();
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  EXPECT_EQ(tasks * (tasks + 1) / 2 - tasks / 2, sum);
+  EXPECT_EQ(0u, queue.size());
+}
+
+}  // namespace shcore
@@ -516,6 +516,23 @@ EXPECT_STDOUT_CONTAINS(
     '" to collection `wl10606`.`2MB_recommended_` in MySQL Server at');
 EXPECT_STDOUT_CONTAINS("Total successfully imported documents 1 ");
 
+//@<> Import documents using multiple threads
+util.importJson(__import_data_path + '/sample.json', {schema: target_schema, collection: 'sample_serial'});
+util.importJson(__import_data_path + '/sample.json', {schema: target_schema, collection: 'sample_parallel', threads: 4});
+EXPECT_STDOUT_CONTAINS(
+    'Importing from file "' + __import_data_path + '/sample.json' +
+    '" to collection `wl10606`.`sample_parallel` in MySQL Server at');
+EXPECT_EQ(session.getSchema(target_schema).getCollection('sample_serial').count(),
+          session.getSchema(target_schema).getCollection('sample_parallel').count());
+
+//@<> Import unterminated document using multiple threads
+var unterminated_file = __tmp_dir + '/unterminated.json';
+testutil.createFile(unterminated_file, '{"a": [' + '1,'.repeat(9 * 1024 * 1024));
+EXPECT_THROWS(function() {
+  util.importJson(unterminated_file, {schema: target_schema, collection: 'unterminated', threads: 4});
+}, "JSON document is not terminated within 16777216 bytes at offset 0");
+testutil.rmfile(unterminated_file);
+
 //@ Import document with size less than mysqlx_max_allowed_packet
 session.close()
 testutil.stopSandbox(target_port);
@@ -15,6 +15,9 @@ FUNCTIONS
       configureOci([profile])
             Wizard to create a valid configuration for the OCI SDK.
 
+      copySchemas(schemas, connectionData[, options])
+            Copies schemas from the current global session to another server.
+
       dumpInstance(outputUrl[, options])
             Dumps the whole database to files in the output directory.
 
@@ -646,6 +649,10 @@ DESCRIPTION
         conversion of the BSON ObjectId values.
       - extractOidTime: string (default: empty) - creates a new field based on
         the ObjectID timestamp. Only valid if convertBsonOid is enabled.
+      - threads: int (default: 1) - number of threads used to parse and insert
+        the documents, each thread uses its own X Protocol session. If more
+        than one thread is used, documents are not inserted in the order in
+        which they appear in the file.
 
       The following options are valid only when convertBsonTypes is enabled.
       They are all boolean flags. ignoreRegexOptions is enabled by default,
@@ -789,7 +796,7 @@ SYNTAX
       util.importTable(filename[, options])
 
 WHERE
-      filename: Path to file with user data
+      filename: Path or list of paths to files with user data
       options: Dictionary with import options
 
 DESCRIPTION
@@ -811,6 +818,12 @@ DESCRIPTION
         and ociConfigFile options will override, respectively, oci.profile and
         oci.configFile shell options.
 
+      If filename is a list of files, all of them are imported into the same
+      target table. The name of a file can contain the '*' and '?' wildcard
+      characters to import all the matching files from a local directory or
+      from an OCI Object Storage bucket. Chunks of all the files are loaded in
+      parallel by the same pool of threads.
+
       Options dictionary:
 
       - schema: string (default: current shell active schema) - Name of target
@@ -846,6 +859,11 @@ DESCRIPTION
         (n * 1'000'000 bytes), G - for Gigabytes (n * 1'000'000'000 bytes),
         bytesPerChunk="2k" - ~2 kilobyte data chunk will send to the MySQL
         Server.
+      - maxBytesPerTransaction: string (minimum: "4096", default: not set) -
+        Maximum number of bytes sent in a single LOAD DATA statement. Each file
+        chunk is split into multiple statements, each one committed separately,
+        which limits the size of transactions executed by the server. Supports
+        the same unit suffixes as bytesPerChunk.
       - maxRate: string (default: "0") - Limit data send throughput to maxRate
         in bytes per second per thread. maxRate="0" - no limit. Unit suffixes,
         k - for Kilobytes (n * 1'000 bytes), M - for Megabytes (n * 1'000'000
@@ -853,8 +871,8 @@ DESCRIPTION
         limit to 2 kilobytes per second.
       - showProgress: bool (default: true if stdout is a tty, false otherwise)
         - Enable or disable import progress information.
-      - skipRows: int (default: 0) - Skip first n rows of the data in the file.
-        You can use this option to skip an initial header line containing
+      - skipRows: int (default: 0) - Skip first n rows of the data in each
+        file. You can use this option to skip an initial header line containing
         column names.
       - dialect: enum (default: "default") - Setup fields and lines options
         that matches specific data file format. Can be used as base dialect and
@@ -1032,15 +1050,59 @@ DESCRIPTION
       - includeTables: array of strings (default not set) - Loads only the
         specified tables from the dump. Strings are in format schema.table or
         `schema`.`table`. By default, all tables from all schemas are included.
+      - indexThreads: int (default: same as threads) - Maximum number of
+        threads used to recreate deferred indexes once the table data is loaded.
+        Tables are processed in order of size, largest first.
       - loadData: bool (default: true) - Loads table data from the dump.
       - loadDdl: bool (default: true) - Executes DDL/SQL scripts in the dump.
       - loadIndexes: bool (default: true) - use together with
         ‘deferTableIndexes’ to control whether secondary indexes should be
         recreated at the end of the load. Useful when loading DDL and data
         separately.
+      - loadInPrimaryKeyOrder: bool (default: false) - If enabled, chunks of
+        tables which were chunked using their primary key are preferably loaded
+        by a single thread at a time, in ascending order of the key, reducing
+        the number of page splits in the clustered index. This is not
+        guaranteed: such tables are loaded by multiple threads if there is no
+        other data to load, and parts of a large chunk may be loaded by
+        multiple threads at the same time.
       - loadUsers: bool (default: false) - Executes SQL scripts for user
         accounts, roles and grants contained in the dump. Note: statements for
         the current user will be skipped.
+      - maxBytesPerTransaction: string (minimum: "4096", default: not set) -
+        Maximum number of bytes sent in a single LOAD DATA statement. Each
+        chunk is split into multiple statements, each one committed separately,
+        which limits the size of undo logs and replication lag caused by large
+        chunks. Supports unit suffixes: k (kilobytes), M (megabytes), G
+        (gigabytes).
+      - maxHistoryListLength: int (default: 0) - If greater than 0, the InnoDB
+        history list length of the target server is checked periodically and
+        the number of threads loading data is reduced while it exceeds this
+        value.
+      - maxMemory: string (default: not set) - Maximum amount of memory used by
+        all threads to buffer data which is read ahead of the LOAD DATA
+        statements, i.e. downloaded or decompressed. Once the limit is reached,
+        threads wait for the memory to be released, but each thread is always
+        able to buffer a single block of data. Supports unit suffixes: k
+        (kilobytes), M (megabytes), G (gigabytes).
+      - maxRate: string (default: "0") - Limit data send throughput to maxRate
+        in bytes per second per thread. maxRate="0" - no limit. Unit suffixes,
+        k - for Kilobytes (n * 1'000 bytes), M - for Megabytes (n * 1'000'000
+        bytes), G - for Gigabytes (n * 1'000'000'000 bytes), maxRate="2k" -
+        limit to 2 kilobytes per second.
+      - maxReplicationLag: int (default: 0) - If greater than 0 and the target
+        server is a replica, its replication lag is checked periodically and
+        the number of threads loading data is reduced while the lag in seconds
+        exceeds this value.
+      - maxThreadsPerTable: int (default: 0) - Maximum number of threads
+        loading data into the same table at the same time. Limits the
+        contention when there are more threads than tables. If set to 0, there
+        is no limit.
+      - maxThreadsRunning: int (default: 0) - If greater than 0, the
+        Threads_running status variable of the target server is checked
+        periodically and the number of threads loading data is reduced while it
+        exceeds this value. The sessions used by the load itself are not
+        counted.
       - progressFile: path (default: <server_uuid>.progress) - Stores load
         progress information in the given local file path.
       - resetProgress: bool (default: false) - Discards progress information of
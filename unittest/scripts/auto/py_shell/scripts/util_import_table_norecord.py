@@ -227,6 +227,26 @@ session.run_sql("truncate table cities_latin2")
 util.import_table(__import_data_path + '/cities_pl_latin2.dump', {'table':'cities_latin2', 'characterSet': 'latin2'})
 shell.dump_rows(session.run_sql('select hex(id), hex(name) from cities_latin2'), "tabbed")
 
+#@<> Corrupted compressed file stops the import
+import gzip
+import os
+
+corrupted_file = os.path.join(__tmp_dir, 'world_x_cities_corrupted.dump.gz')
+
+with open(__import_data_path + '/world_x_cities.dump', 'rb') as f:
+    compressed = gzip.compress(f.read())
+
+# overwrite the middle of the compressed stream, rows before it are decompressed
+middle = len(compressed) // 2
+
+with open(corrupted_file, 'wb') as f:
+    f.write(compressed[:middle] + b'\0' * 64 + compressed[middle + 64:])
+
+EXPECT_THROWS(lambda: util.import_table(corrupted_file, { "schema": target_schema, "table": 'cities', "bytesPerChunk": "128k" }),
+    "inflate: data error")
+
+os.remove(corrupted_file)
+
 #@<> Teardown
 session.run_sql("DROP SCHEMA IF EXISTS " + target_schema)
 session.close()